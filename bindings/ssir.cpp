@@ -5,13 +5,104 @@
 
 #include <memory>
 
+#include "calibrator.h"
+#include "class_table.h"
 #include "disease.h"
+#include "layout.h"
+#include "memory.h"
+#include "metrics.h"
 #include "model.h"
 #include "person.h"
 #include "population.h"
+#include "random.h"
+#include "record_policy.h"
+#include "renderer.h"
+#include "schedule.h"
+#include "topology.h"
+#include "transmission_log.h"
 
 namespace py = pybind11;
 
+std::vector<int> to_cells(const Population &population, const py::array &cells) {
+    const int64_t count = static_cast<int64_t>(population.get_size()) * population.get_size();
+    std::vector<int> result;
+
+    // Boolean masks select cells, integers are flat row-major indices
+    // NOTE: Floats would be truncated to indices, so they are refused. An empty list arrives as
+    // float64 though, and selects nothing.
+    char kind = cells.dtype().kind();
+    if (kind != 'b' && cells.size() == 0) return result;
+    if (kind != 'b' && kind != 'i' && kind != 'u') {
+        throw py::type_error("Cells must be an integer index array or a boolean mask");
+    }
+    if (kind == 'b') {
+        auto mask = py::array_t<bool, py::array::c_style | py::array::forcecast>::ensure(cells);
+        if (mask.size() != count) {
+            throw std::invalid_argument("Mask must have size x size elements");
+        }
+        const bool *m = mask.data();
+        for (int64_t c = 0; c < count; ++c) {
+            if (m[c]) result.push_back(static_cast<int>(c));
+        }
+        return result;
+    }
+
+    // NOTE: Only integer dtypes get here, so forcecast widens them and never truncates
+    auto index = py::array_t<int64_t, py::array::c_style | py::array::forcecast>::ensure(cells);
+    const int64_t *p = index.data();
+    result.reserve(index.size());
+    for (py::ssize_t k = 0; k < index.size(); ++k) {
+        if (p[k] < 0 || p[k] >= count) {
+            throw std::invalid_argument("Cell index out of range");
+        }
+        result.push_back(static_cast<int>(p[k]));
+    }
+    return result;
+}
+
+// Hand an immutable Topology to Python, which has no way to change it
+std::shared_ptr<Topology> share_topology(std::shared_ptr<const Topology> topology) {
+    return std::const_pointer_cast<Topology>(std::move(topology));
+}
+
+// Convert a MemoryUsage into a dict of byte counts, with the total under "total"
+py::dict memory_dict(const MemoryUsage &usage) {
+    py::dict result;
+    result["people"] = usage.people;
+    result["neighbors"] = usage.neighbors;
+    result["infectious"] = usage.infectious;
+    result["tables"] = usage.tables;
+    result["log"] = usage.log;
+    result["history"] = usage.history;
+    result["total"] = usage.total();
+    return result;
+}
+
+template <typename T>
+py::array_t<uint8_t> render_array(
+    const Renderer &renderer, const py::array_t<T, py::array::c_style | py::array::forcecast> &data) {
+    if (data.ndim() != 2 && data.ndim() != 3) {
+        throw std::invalid_argument("Data must be a 2D grid or a 3D stack of grids");
+    }
+    bool single = data.ndim() == 2;
+    int frames = single ? 1 : static_cast<int>(data.shape(0));
+    int height = static_cast<int>(data.shape(single ? 0 : 1));
+    int width = static_cast<int>(data.shape(single ? 1 : 2));
+    size_t out_height = renderer.get_output_height(height);
+    size_t out_width = renderer.get_output_width(width);
+
+    py::array_t<uint8_t> array =
+        single ? py::array_t<uint8_t>({out_height, out_width, size_t(3)})
+               : py::array_t<uint8_t>({size_t(frames), out_height, out_width, size_t(3)});
+    const T *in = data.data();
+    uint8_t *out = array.mutable_data();
+    {
+        py::gil_scoped_release release;
+        renderer.render(in, frames, height, width, out);
+    }
+    return array;
+}
+
 PYBIND11_MAKE_OPAQUE(std::vector<int>);
 PYBIND11_MAKE_OPAQUE(std::vector<std::vector<int>>);
 PYBIND11_MAKE_OPAQUE(std::vector<std::vector<std::vector<int>>>);
@@ -36,6 +127,28 @@ PYBIND11_MODULE(ssir, m) {
         .value("Dead", Status::Dead, "Dead")
         .export_values();
 
+    // Bind Parameter enum
+    py::enum_<Parameter>(m, "Parameter", "Simulation parameter a Schedule can change")
+        .value("Encounters", Parameter::Encounters, "Population encounters per person")
+        .value("TravelRadius", Parameter::TravelRadius, "Population travel radius")
+        .value("TransmissionRate", Parameter::TransmissionRate, "Disease transmission rate")
+        .value("FatalityRate", Parameter::FatalityRate, "Disease fatality rate")
+        .export_values();
+
+    // Bind Layout enum
+    py::enum_<Layout>(m, "Layout", "Order in which grid cells are stored in memory")
+        .value("RowMajor", Layout::RowMajor, "Row after row")
+        .value("Morton", Layout::Morton, "Z-order curve")
+        .value("Tiled", Layout::Tiled, "Square tiles, row-major inside each tile")
+        .export_values();
+
+    // Bind RandomMode enum
+    py::enum_<RandomMode>(m, "RandomMode", "How a Population produces random draws")
+        .value("Sequential", RandomMode::Sequential, "One stream consumed in order")
+        .value("Keyed", RandomMode::Keyed,
+               "Draws keyed by (seed, day, cell, purpose), shared by runs whose states agree")
+        .export_values();
+
     // Bind Disease class
     py::class_<Disease, std::shared_ptr<Disease>>(
         m, "Disease", "Represents a disease with epidemiological parameters")
@@ -61,14 +174,210 @@ PYBIND11_MODULE(ssir, m) {
                       &Disease::set_days_with_symptoms, "Days with symptoms.")
         .def_property("name", &Disease::get_name, &Disease::set_name, "Name of the disease.");
 
+    // Bind ClassParameters struct
+    py::class_<ClassParameters>(m, "ClassParameters",
+                                "Disease parameters shared by every person of one class")
+        .def(py::init([](double susceptibility, double fatality_rate, int days_in_incubation,
+                         int days_with_symptoms) {
+                 return ClassParameters{susceptibility, fatality_rate, days_in_incubation,
+                                        days_with_symptoms};
+             }),
+             py::arg("susceptibility"), py::arg("fatality_rate"), py::arg("days_in_incubation"),
+             py::arg("days_with_symptoms"),
+             "Initialize the parameters of one class.\n"
+             "Args:\n"
+             "    susceptibility (float): Multiplier on the chance of being infected.\n"
+             "    fatality_rate (float): Probability of fatal outcome (0 to 1).\n"
+             "    days_in_incubation (int): Number of days in incubation period.\n"
+             "    days_with_symptoms (int): Number of days with symptoms.")
+        .def_readwrite("susceptibility", &ClassParameters::susceptibility,
+                       "Multiplier on the chance of being infected.")
+        .def_readwrite("fatality_rate", &ClassParameters::fatality_rate,
+                       "Probability of fatal outcome (0 to 1).")
+        .def_readwrite("days_in_incubation", &ClassParameters::days_in_incubation,
+                       "Number of days in incubation period.")
+        .def_readwrite("days_with_symptoms", &ClassParameters::days_with_symptoms,
+                       "Number of days with symptoms.");
+
+    // Bind ClassTable class
+    py::class_<ClassTable, std::shared_ptr<ClassTable>>(
+        m, "ClassTable", "Per-class parameters indexed by a uint8 class per cell")
+        .def(py::init<const std::vector<ClassParameters> &>(), py::arg("classes"),
+             "Initialize a ClassTable from the parameters of each class.\n"
+             "Args:\n"
+             "    classes (list[ClassParameters]): Parameters indexed by class id (1 to 256).\n"
+             "Raises:\n"
+             "    ValueError: If parameters are invalid.")
+        .def("__len__", &ClassTable::get_size)
+        .def(
+            "__getitem__",
+            [](const ClassTable &self, int index) {
+                if (index < 0 || index >= self.get_size()) throw py::index_error();
+                return self.get(index);
+            },
+            py::arg("index"))
+        .def_property_readonly("classes", &ClassTable::get_classes,
+                               "Parameters of each class.");
+
+    // Bind TransmissionLog class
+    py::class_<TransmissionLog, std::shared_ptr<TransmissionLog>>(
+        m, "TransmissionLog", "Columnar record of who infected whom and when")
+        .def("__len__", &TransmissionLog::get_size)
+        .def_property_readonly("chunk_count", &TransmissionLog::get_chunk_count,
+                               "Number of storage chunks.")
+        .def(
+            "chunk",
+            [](const std::shared_ptr<TransmissionLog> &self, int chunk) {
+                // Views into the chunk, kept alive by a reference to the log
+                size_t count = self->get_chunk_size(chunk);
+                py::object owner = py::cast(self);
+                auto view = [&](const uint32_t *column) {
+                    py::array_t<uint32_t> array(count, column, owner);
+                    // NOTE: The log owns the memory, writing through a view would rewrite it
+                    array.attr("flags").attr("writeable") = false;
+                    return array;
+                };
+                return py::make_tuple(view(self->get_infectors(chunk)),
+                                      view(self->get_infectees(chunk)),
+                                      view(self->get_days(chunk)));
+            },
+            py::arg("chunk"),
+            "Zero-copy read-only views of one chunk.\n"
+            "Returns:\n"
+            "    tuple[np.ndarray, np.ndarray, np.ndarray]: uint32 infector cells, infectee\n"
+            "    cells and days.")
+        .def(
+            "to_numpy",
+            [](const TransmissionLog &self) {
+                size_t size = self.get_size();
+                py::array_t<uint32_t> infectors(size), infectees(size), days(size);
+                size_t offset = 0;
+                for (int c = 0; c < self.get_chunk_count(); ++c) {
+                    size_t count = self.get_chunk_size(c);
+                    std::copy_n(self.get_infectors(c), count, infectors.mutable_data() + offset);
+                    std::copy_n(self.get_infectees(c), count, infectees.mutable_data() + offset);
+                    std::copy_n(self.get_days(c), count, days.mutable_data() + offset);
+                    offset += count;
+                }
+                py::dict columns;
+                columns["infector"] = infectors;
+                columns["infectee"] = infectees;
+                columns["day"] = days;
+                return columns;
+            },
+            "Copy the whole log into contiguous columns.\n"
+            "Returns:\n"
+            "    dict[str, np.ndarray]: uint32 arrays under infector, infectee and day.");
+
+    // Bind Topology class
+    py::class_<Topology, std::shared_ptr<Topology>>(
+        m, "Topology", "Immutable grid structure that many Populations can share")
+        .def(py::init([](int size, int travel_radius, Layout layout, int tile,
+                         bool neighbor_cache) {
+                 py::gil_scoped_release release;
+                 return std::make_shared<Topology>(size, travel_radius, layout, tile,
+                                                   neighbor_cache);
+             }),
+             py::arg("size"), py::arg("travel_radius"), py::arg("layout") = Layout::RowMajor,
+             py::arg("tile") = 16, py::arg("neighbor_cache") = true,
+             "Initialize a Topology, precomputing its neighbor table.\n"
+             "Args:\n"
+             "    size (int): Grid size (size x size, positive).\n"
+             "    travel_radius (int): Maximum encounter distance (non-negative).\n"
+             "    layout (Layout, optional): Order of cells in memory.\n"
+             "    tile (int, optional): Tile size for Layout.Tiled (positive).\n"
+             "    neighbor_cache (bool, optional): Precompute neighbors, else sample them.\n"
+             "Raises:\n"
+             "    ValueError: If parameters are invalid.")
+        .def(
+            "with_travel_radius",
+            [](const Topology &self, int radius) {
+                py::gil_scoped_release release;
+                return share_topology(self.with_travel_radius(radius));
+            },
+            py::arg("radius"), "Copy with another travel radius.")
+        .def(
+            "with_layout",
+            [](const Topology &self, Layout layout, int tile) {
+                py::gil_scoped_release release;
+                return share_topology(self.with_layout(layout, tile));
+            },
+            py::arg("layout"), py::arg("tile") = 16, "Copy with another cell order.")
+        .def(
+            "with_neighbor_cache",
+            [](const Topology &self, bool enabled) {
+                py::gil_scoped_release release;
+                return share_topology(self.with_neighbor_cache(enabled));
+            },
+            py::arg("enabled"), "Copy with or without the neighbor table.")
+        .def(
+            "with_classes",
+            [](const Topology &self,
+               const py::array_t<uint8_t, py::array::c_style | py::array::forcecast> &classes,
+               std::shared_ptr<ClassTable> table) {
+                std::vector<uint8_t> values(classes.data(), classes.data() + classes.size());
+                return share_topology(self.with_classes(values, std::move(table)));
+            },
+            py::arg("classes"), py::arg("table"),
+            "Copy with a class for every cell, sharing the neighbor table.\n"
+            "Args:\n"
+            "    classes (np.ndarray): uint8 class of each cell, shape (size, size).\n"
+            "    table (ClassTable): Parameters of each class.\n"
+            "Raises:\n"
+            "    ValueError: If the shape or a class index is invalid.")
+        .def(
+            "without_classes",
+            [](const Topology &self) { return share_topology(self.without_classes()); },
+            "Copy without classes.")
+        .def(
+            "with_zones",
+            [](const Topology &self,
+               const py::array_t<int, py::array::c_style | py::array::forcecast> &zones) {
+                std::vector<int> labels(zones.data(), zones.data() + zones.size());
+                return share_topology(self.with_zones(labels));
+            },
+            py::arg("zones"),
+            "Copy with a zone label for every cell, sharing the neighbor table.\n"
+            "Args:\n"
+            "    zones (np.ndarray): Non-negative int label of each cell, shape (size, size).\n"
+            "Raises:\n"
+            "    ValueError: If the shape or a label is invalid.")
+        .def(
+            "without_zones",
+            [](const Topology &self) { return share_topology(self.without_zones()); },
+            "Copy without zones.")
+        .def_property_readonly("size", &Topology::get_size, "Grid size (size x size).")
+        .def_property_readonly("travel_radius", &Topology::get_travel_radius,
+                               "Maximum encounter distance.")
+        .def_property_readonly("layout", &Topology::get_layout, "Order of cells in memory.")
+        .def_property_readonly("tile", &Topology::get_tile, "Tile size for Layout.Tiled.")
+        .def_property_readonly("neighbor_cache", &Topology::get_neighbor_cache,
+                               "Whether the neighbor table is precomputed.")
+        .def_property_readonly("zone_count", &Topology::get_zone_count, "Number of zones.")
+        .def_property_readonly("class_table", &Topology::get_class_table,
+                               "Parameters of each class, or None.")
+        .def_property_readonly(
+            "memory", [](const Topology &self) { return memory_dict(self.get_memory()); },
+            "Bytes held by the topology, as a dict.")
+        .def_static(
+            "estimate_memory",
+            [](int size, int travel_radius, bool neighbor_cache) {
+                return memory_dict(Topology::estimate_memory(size, travel_radius, neighbor_cache));
+            },
+            py::arg("size"), py::arg("travel_radius"), py::arg("neighbor_cache") = true,
+            "Bytes a new topology would hold, without allocating it.\n"
+            "Returns:\n"
+            "    dict[str, int]: Bytes per part and their total.");
+
     // Bind Population class
     py::class_<Population, std::shared_ptr<Population>>(
         m, "Population", "Represents a population on a grid for simulating disease spread")
         .def(py::init<int, int, int, int, int, std::shared_ptr<Disease>, unsigned int,
-                      const std::string &>(),
+                      const std::string &, RandomMode, size_t>(),
              py::arg("size"), py::arg("travel_radius"), py::arg("encounters"),
              py::arg("init_incubations"), py::arg("init_infections"), py::arg("disease"),
              py::arg("seed") = 0, py::arg("name") = "",
+             py::arg("random_mode") = RandomMode::Sequential, py::arg("memory_cap") = 0,
              "Initialize a Population with the given parameters.\n"
              "Args:\n"
              "    size (int): Grid size (size x size, positive).\n"
@@ -79,12 +388,269 @@ PYBIND11_MODULE(ssir, m) {
              "    disease (Disease): Disease parameters.\n"
              "    seed (int): Seed for the RNG.\n"
              "    name (str, optional): Name of the population.\n"
+             "    random_mode (RandomMode, optional): Keyed for common random numbers across runs.\n"
+             "    memory_cap (int, optional): Bytes allowed, 0 for no cap. Neighbors are sampled\n"
+             "        on the fly when their table would not fit.\n"
+             "Raises:\n"
+             "    ValueError: If parameters are invalid or the population cannot fit the cap.")
+        .def(py::init([](std::shared_ptr<Topology> topology, int encounters, int init_incubations,
+                         int init_infections, std::shared_ptr<Disease> disease, unsigned int seed,
+                         const std::string &name, RandomMode random_mode) {
+                 py::gil_scoped_release release;
+                 return std::make_shared<Population>(std::move(topology), encounters,
+                                                     init_incubations, init_infections,
+                                                     std::move(disease), seed, name, random_mode);
+             }),
+             py::arg("topology"), py::arg("encounters"), py::arg("init_incubations"),
+             py::arg("init_infections"), py::arg("disease"), py::arg("seed") = 0,
+             py::arg("name") = "", py::arg("random_mode") = RandomMode::Sequential,
+             "Initialize a Population on a shared Topology, allocating only per-person state.\n"
+             "Args:\n"
+             "    topology (Topology): Grid structure, shared with other populations.\n"
+             "    encounters (int): Number of interactions per person (non-negative).\n"
+             "    init_incubations (int): Number of initially incubated persons (non-negative).\n"
+             "    init_infections (int): Number of initially infected persons (non-negative).\n"
+             "    disease (Disease): Disease parameters.\n"
+             "    seed (int): Seed for the RNG.\n"
+             "    name (str, optional): Name of the population.\n"
+             "    random_mode (RandomMode, optional): Keyed for common random numbers across runs.\n"
              "Raises:\n"
              "    ValueError: If parameters are invalid.")
-        .def("update", &Population::update, "Update the population for one time step.")
+        .def("update", &Population::update, py::call_guard<py::gil_scoped_release>(),
+             "Update the population for one time step.")
         .def(
             "reset", [](Population &self, bool same_seed) { self.reset(same_seed); },
             py::arg("same_seed") = false, "Reset the population to its initial state.")
+        .def(
+            "vaccinate",
+            [](Population &self, const py::array &cells) {
+                std::vector<int> targets = to_cells(self, cells);
+                py::gil_scoped_release release;
+                return self.vaccinate(targets);
+            },
+            py::arg("cells"),
+            "Move susceptible cells to Recovered.\n"
+            "Args:\n"
+            "    cells (np.ndarray): Flat row-major indices or a boolean mask of shape (size, size).\n"
+            "Returns:\n"
+            "    int: Number of people vaccinated.\n"
+            "Raises:\n"
+            "    ValueError: If an index is out of range.\n"
+            "    TypeError: If cells are neither integers nor booleans.")
+        .def(
+            "seed_incubations",
+            [](Population &self, const py::array &cells, int strain) {
+                std::vector<int> targets = to_cells(self, cells);
+                py::gil_scoped_release release;
+                return self.seed_incubations(targets, strain);
+            },
+            py::arg("cells"), py::arg("strain") = 0,
+            "Move susceptible cells to Incubated.\n"
+            "Args:\n"
+            "    cells (np.ndarray): Flat row-major indices or a boolean mask of shape (size, size).\n"
+            "    strain (int): Strain the cells are incubated with, 0 is the disease.\n"
+            "Returns:\n"
+            "    int: Number of people incubated.\n"
+            "Raises:\n"
+            "    ValueError: If an index or the strain is out of range.\n"
+            "    TypeError: If cells are neither integers nor booleans.")
+        .def(
+            "isolate",
+            [](Population &self, const py::array &cells, int days) {
+                std::vector<int> targets = to_cells(self, cells);
+                py::gil_scoped_release release;
+                return self.isolate(targets, days);
+            },
+            py::arg("cells"), py::arg("days"),
+            "Remove cells from encounters for the given number of days.\n"
+            "Args:\n"
+            "    cells (np.ndarray): Flat row-major indices or a boolean mask of shape (size, size).\n"
+            "    days (int): Number of days in isolation (non-negative).\n"
+            "Returns:\n"
+            "    int: Number of people newly isolated.\n"
+            "Raises:\n"
+            "    ValueError: If an index is out of range or days is negative.\n"
+            "    TypeError: If cells are neither integers nor booleans.")
+        .def(
+            "set_classes",
+            [](Population &self,
+               const py::array_t<uint8_t, py::array::c_style | py::array::forcecast> &classes,
+               std::shared_ptr<ClassTable> table) {
+                std::vector<uint8_t> values(classes.data(), classes.data() + classes.size());
+                self.set_classes(values, std::move(table));
+            },
+            py::arg("classes"), py::arg("table"),
+            "Assign a class to every cell.\n"
+            "Args:\n"
+            "    classes (np.ndarray): uint8 class of each cell, shape (size, size).\n"
+            "    table (ClassTable): Parameters of each class.\n"
+            "Raises:\n"
+            "    ValueError: If the shape or a class index is invalid.")
+        .def("load_classes", &Population::load_classes, py::arg("path"), py::arg("table"),
+             "Assign a class to every cell from a PGM raster of size x size.\n"
+             "Raises:\n"
+             "    ValueError: If the raster or a class index is invalid.")
+        .def("clear_classes", &Population::clear_classes,
+             "Drop the classes, every cell uses the Disease parameters again.")
+        .def_property_readonly(
+            "classes",
+            [](const Population &self) -> py::object {
+                const auto &classes = self.get_classes();
+                if (classes.empty()) return py::none();
+                size_t size = self.get_size();
+                py::array_t<uint8_t> array({size, size});
+                std::copy(classes.begin(), classes.end(), array.mutable_data());
+                return std::move(array);
+            },
+            "2D uint8 array of cell classes, or None.")
+        .def_property_readonly("class_table", &Population::get_class_table,
+                               "Parameters of each class, or None.")
+        .def(
+            "set_layout",
+            [](Population &self, Layout layout, int tile) {
+                py::gil_scoped_release release;
+                self.set_layout(layout, tile);
+            },
+            py::arg("layout"), py::arg("tile") = 16,
+            "Reorder the cells in memory, keeping every person's state.\n"
+            "Results for a given seed do not depend on the layout, only speed does.\n"
+            "Args:\n"
+            "    layout (Layout): New cell order.\n"
+            "    tile (int): Tile size for Layout.Tiled (positive).\n"
+            "Raises:\n"
+            "    ValueError: If tile is not positive.")
+        .def_property_readonly("layout", &Population::get_layout, "Order of cells in memory.")
+        .def_property_readonly("tile", &Population::get_tile, "Tile size for Layout.Tiled.")
+        .def_property("random_mode", &Population::get_random_mode, &Population::set_random_mode,
+                      "How random draws are produced, applies to draws from now on.")
+        .def_property("neighbor_cache", &Population::get_neighbor_cache,
+                      &Population::set_neighbor_cache,
+                      "Whether neighbor lists are precomputed, the same people are met either way.")
+        .def_property("batched", &Population::get_batched, &Population::set_batched,
+                      "Whether encounters are gathered and resolved grouped by target. With keyed\n"
+                      "draws and a single strain the results are the same either way.")
+        .def_property_readonly(
+            "topology", [](const Population &self) { return share_topology(self.get_topology()); },
+            "Grid structure, shared with other populations built on it. Setters that change it\n"
+            "give this population its own copy.")
+        .def_property_readonly(
+            "memory", [](const Population &self) { return memory_dict(self.get_memory()); },
+            "Bytes held by each part of the population, as a dict.")
+        .def_property_readonly(
+            "state_memory",
+            [](const Population &self) { return memory_dict(self.get_memory(false)); },
+            "Bytes held by the population without its topology, as a dict.")
+        .def_static(
+            "estimate_memory",
+            [](int size, int travel_radius, bool neighbor_cache, int batched_encounters) {
+                return memory_dict(Population::estimate_memory(size, travel_radius,
+                                                               neighbor_cache, batched_encounters));
+            },
+            py::arg("size"), py::arg("travel_radius"), py::arg("neighbor_cache") = true,
+            py::arg("batched_encounters") = 0,
+            "Bytes a new population would hold, without allocating it.\n"
+            "Args:\n"
+            "    batched_encounters (int, optional): Encounters per person when batched, counting\n"
+            "        the encounter buffers at peak. 0 when not batched.\n"
+            "Returns:\n"
+            "    dict[str, int]: Bytes per part and their total.")
+        .def("enable_transmission_log", &Population::enable_transmission_log,
+             "Start recording (infector cell, infectee cell, day) for every infection.")
+        .def("disable_transmission_log", &Population::disable_transmission_log,
+             "Stop recording infections and drop the log.")
+        .def_property_readonly("transmission_log", &Population::get_transmission_log,
+                               "Log of infections, or None when disabled.")
+        .def_property_readonly("day", &Population::get_day,
+                               "Number of updates since construction or reset.")
+        .def("add_strain", &Population::add_strain, py::arg("disease"),
+             py::arg("cross_immunity") = 1.0,
+             "Add a strain that spreads on the same grid in the same update pass.\n"
+             "Args:\n"
+             "    disease (Disease): Parameters of the new strain.\n"
+             "    cross_immunity (float): Protection between it and every existing strain (0 to 1).\n"
+             "Returns:\n"
+             "    int: Index of the new strain.\n"
+             "Raises:\n"
+             "    ValueError: If parameters are invalid or there are already 32 strains.")
+        .def("set_cross_immunity", &Population::set_cross_immunity, py::arg("source"),
+             py::arg("target"), py::arg("protection"),
+             "Set how much recovering from one strain protects against another.\n"
+             "Args:\n"
+             "    source (int): Strain recovered from.\n"
+             "    target (int): Strain challenging the recovered person.\n"
+             "    protection (float): Probability the infection is blocked (0 to 1).\n"
+             "Raises:\n"
+             "    ValueError: If a strain is out of range or protection is invalid.")
+        .def("get_cross_immunity", &Population::get_cross_immunity, py::arg("source"),
+             py::arg("target"), "Protection from recovering from source against target.")
+        .def("strain", &Population::get_strain, py::arg("strain"), "Parameters of a strain.")
+        .def_property_readonly("strain_count", &Population::get_strain_count,
+                               "Number of strains, 1 unless strains were added.")
+        .def_property_readonly(
+            "strain_stats",
+            [](const Population &self) {
+                const auto &counts = self.get_strain_counts();
+                size_t strains = self.get_strain_count();
+                py::array_t<int> array({strains, size_t(3)});
+                std::copy(counts.begin(), counts.end(), array.mutable_data());
+                return array;
+            },
+            "2D array of Incubated, Infected and total infections for each strain (strains, 3).")
+        .def_property_readonly(
+            "strains",
+            [](const Population &self) {
+                const auto data = self.get_strain_grid();
+                size_t size = data.size();
+                py::array_t<int> array({size, size});
+                auto r = array.mutable_unchecked<2>();
+                for (size_t i = 0; i < size; ++i) {
+                    for (size_t j = 0; j < size; ++j) {
+                        r(i, j) = data[i][j];
+                    }
+                }
+                return array;
+            },
+            "2D array of the strain of each person's current or last infection, -1 if none.")
+        .def(
+            "set_zones",
+            [](Population &self,
+               const py::array_t<int, py::array::c_style | py::array::forcecast> &zones) {
+                std::vector<int> labels(zones.data(), zones.data() + zones.size());
+                self.set_zones(labels);
+            },
+            py::arg("zones"),
+            "Assign a zone label to every cell, counts are then kept per zone.\n"
+            "Args:\n"
+            "    zones (np.ndarray): Non-negative int label of each cell, shape (size, size).\n"
+            "Raises:\n"
+            "    ValueError: If the shape or a label is invalid.")
+        .def("load_zones", &Population::load_zones, py::arg("path"),
+             "Assign a zone label to every cell from a PGM raster of size x size.\n"
+             "Raises:\n"
+             "    ValueError: If the raster is invalid.")
+        .def("clear_zones", &Population::clear_zones, "Drop the zone labels.")
+        .def_property_readonly(
+            "zones",
+            [](const Population &self) -> py::object {
+                const auto &zones = self.get_zones();
+                if (zones.empty()) return py::none();
+                size_t size = self.get_size();
+                py::array_t<int> array({size, size});
+                std::copy(zones.begin(), zones.end(), array.mutable_data());
+                return std::move(array);
+            },
+            "2D array of cell zone labels, or None.")
+        .def_property_readonly("zone_count", &Population::get_zone_count, "Number of zones.")
+        .def_property_readonly(
+            "zone_stats",
+            [](const Population &self) {
+                const auto &counts = self.get_zone_counts();
+                size_t zones = self.get_zone_count();
+                py::array_t<int> array({zones, size_t(5)});
+                std::copy(counts.begin(), counts.end(), array.mutable_data());
+                return array;
+            },
+            "2D array of counts for each zone and status (zones, 5).")
         .def_property_readonly(
             "people",
             [](const Population &self) {
@@ -117,52 +683,144 @@ PYBIND11_MODULE(ssir, m) {
                       &Population::set_travel_radius, "Maximum encounter distance (non-negative).")
         .def_property("encounters", &Population::get_encounters, &Population::set_encounters,
                       "Number of interactions per person (non-negative).")
+        .def_property_readonly("disease", &Population::get_disease,
+                               "Disease parameters as given, strain(0) has scheduled overrides.")
         .def_property("name", &Population::get_name, &Population::set_name,
                       "Name of the population.")
         .def_property("seed", &Population::get_seed, &Population::set_seed, "Seed of the RNG.");
 
+    // Bind RecordPolicy class
+    py::class_<RecordPolicy>(m, "RecordPolicy",
+                             "Decides which days a Model records as spatial frames")
+        .def(py::init<>(), "Initialize a policy recording a full frame every day.")
+        .def_static("full", &RecordPolicy::full, "Record a full frame every day.")
+        .def_static("stats_only", &RecordPolicy::stats_only,
+                    "Record status counts only, no spatial frames.")
+        .def_static("every", &RecordPolicy::every, py::arg("stride"),
+                    "Record a frame every stride-th day (day 0 included).\n"
+                    "Raises:\n"
+                    "    ValueError: If stride is not positive.")
+        .def_static("on_days", &RecordPolicy::on_days, py::arg("days"),
+                    "Record frames only on the given days.\n"
+                    "Raises:\n"
+                    "    ValueError: If a day is negative.")
+        .def("set_region", &RecordPolicy::set_region, py::arg("row"), py::arg("col"),
+             py::arg("height"), py::arg("width"),
+             "Crop recorded frames to a region of interest.\n"
+             "Raises:\n"
+             "    ValueError: If the region is invalid.")
+        .def("clear_region", &RecordPolicy::clear_region, "Record the whole grid again.")
+        .def("records", &RecordPolicy::records, py::arg("day"),
+             "Whether a frame is recorded on the given day.")
+        .def_property_readonly("frames", &RecordPolicy::get_frames,
+                               "Whether spatial frames are recorded.")
+        .def_property("metrics", &RecordPolicy::get_metrics, &RecordPolicy::set_metrics,
+                      "Whether spatial metrics are computed each day.")
+        .def_property_readonly("stride", &RecordPolicy::get_stride, "Frame stride in days.")
+        .def_property_readonly("days", &RecordPolicy::get_days, "Explicit recorded days.")
+        .def_property_readonly(
+            "region",
+            [](const RecordPolicy &self) -> py::object {
+                if (!self.has_region()) return py::none();
+                return py::make_tuple(self.get_row(), self.get_col(), self.get_height(),
+                                      self.get_width());
+            },
+            "Region of interest as (row, col, height, width), or None for the whole grid.");
+
+    // Bind Schedule class
+    py::class_<Schedule, std::shared_ptr<Schedule>>(
+        m, "Schedule", "Day-indexed and threshold-triggered parameter changes")
+        .def(py::init<>(), "Initialize an empty Schedule.")
+        .def("add_change", &Schedule::add_change, py::arg("day"), py::arg("parameter"),
+             py::arg("value"),
+             "Set a parameter at the start of the given day.\n"
+             "Args:\n"
+             "    day (int): Day on which the change takes effect (positive).\n"
+             "    parameter (Parameter): Parameter to change.\n"
+             "    value (float): New value of the parameter.\n"
+             "Raises:\n"
+             "    ValueError: If day or value is invalid.")
+        .def("add_rule", &Schedule::add_rule, py::arg("status"), py::arg("threshold"),
+             py::arg("parameter"), py::arg("value"), py::arg("above") = true,
+             py::arg("once") = true,
+             "Set a parameter once a status count crosses a threshold.\n"
+             "Args:\n"
+             "    status (Status): Status whose count is watched.\n"
+             "    threshold (int): Count that triggers the rule (non-negative).\n"
+             "    parameter (Parameter): Parameter to change.\n"
+             "    value (float): New value of the parameter.\n"
+             "    above (bool): Trigger when count >= threshold, else when count <= threshold.\n"
+             "    once (bool): Fire only the first time the condition holds.\n"
+             "Raises:\n"
+             "    ValueError: If threshold or value is invalid.")
+        .def("clear", &Schedule::clear, "Remove all changes and rules.")
+        .def_property_readonly("change_count", &Schedule::get_change_count,
+                               "Number of day-indexed changes.")
+        .def_property_readonly("rule_count", &Schedule::get_rule_count,
+                               "Number of threshold rules.");
+
     // Bind Model class
     py::class_<Model>(m, "Model", "Represents a SIR model for simulating disease spread")
-        .def(py::init<int, std::shared_ptr<Population>, const std::string &>(),
+        .def(py::init<int, std::shared_ptr<Population>, const std::string &,
+                      const RecordPolicy &, size_t, const std::string &>(),
              py::arg("days_in_simulation"), py::arg("population"), py::arg("name") = "",
+             py::arg("record") = RecordPolicy(), py::arg("memory_cap") = 0,
+             py::arg("frames_path") = "",
              "Initialize a Model with the given Population.\n"
              "Args:\n"
              "    days_in_simulation (int): Total number of days to simulate (non-negative).\n"
              "    population (Population): The population being simulated.\n"
              "    name (str, optional): Name of the model.\n"
+             "    record (RecordPolicy, optional): Which frames to record.\n"
+             "    memory_cap (int, optional): Bytes allowed for population and history, 0 for no\n"
+             "        cap. Drops the neighbor cache, then frames, until the estimate fits.\n"
+             "    frames_path (str, optional): Binary frame file written while simulating, in\n"
+             "        which case data stays empty. Empty to hold frames in memory.\n"
              "Raises:\n"
-             "    ValueError: If parameters are invalid.")
+             "    ValueError: If parameters are invalid or the model cannot fit the cap.\n"
+             "    RuntimeError: If the frame file cannot be written.")
         .def(
-            "simulate", [](Model &self, int days) { return self.simulate(days); }, py::arg("days"),
+            "simulate",
+            [](Model &self, int days, const std::shared_ptr<Schedule> &schedule) {
+                py::gil_scoped_release release;
+                return self.simulate(days, schedule);
+            },
+            py::arg("days"), py::arg("schedule") = nullptr,
             "Simulate the population for the given number of days.\n"
             "Args:\n"
             "    days (int): Number of days to simulate.\n"
+            "    schedule (Schedule, optional): Parameter changes applied during the run.\n"
             "Returns:\n"
             "    bool: True if simulation succeeded.\n"
             "Raises:\n"
-            "    ValueError: If days is invalid.")
+            "    ValueError: If days is invalid.\n"
+            "    RuntimeError: If the population zones changed since the last reset.")
         .def(
             "reset", [](Model &self, bool same_seed) { self.reset(same_seed); },
-            py::arg("same_seed") = false, "Reset the model to its initial state")
+            py::arg("same_seed") = false,
+            "Reset the model to its initial state, undoing scheduled changes and re-arming\n"
+            "their rules.")
         .def_property_readonly(
             "data",
             [](const Model &self) {
-                const auto &data = self.get_data();
-                if (data.empty()) return py::array_t<int>({0, 0, 0});
-                size_t time = data.size();
-                size_t size = data[0].size();
-                py::array_t<int> array({time, size, size});
-                auto r = array.mutable_unchecked<3>();
-                for (size_t i = 0; i < time; ++i) {
-                    for (size_t j = 0; j < size; ++j) {
-                        for (size_t k = 0; k < size; ++k) {
-                            r(i, j, k) = data[i][j][k];
-                        }
-                    }
-                }
+                const auto &frames = self.get_frames();
+                size_t time = self.get_frame_count();
+                size_t height = self.get_frame_height();
+                size_t width = self.get_frame_width();
+                py::array_t<int> array({time, height, width});
+                std::copy(frames.begin(), frames.end(), array.mutable_data());
+                return array;
+            },
+            "3D array of population states for each recorded day.")
+        .def_property_readonly(
+            "frame_days",
+            [](const Model &self) {
+                const auto &days = self.get_frame_days();
+                py::array_t<int> array(days.size());
+                std::copy(days.begin(), days.end(), array.mutable_data());
                 return array;
             },
-            "3D array of population states for each day.")
+            "Day of each recorded frame in data.")
         .def_property_readonly(
             "stats",
             [](const Model &self) {
@@ -179,9 +837,213 @@ PYBIND11_MODULE(ssir, m) {
                 }
                 return array;
             },
-            "2D array of status counts for each day.")
+            "2D array of status counts for each day, followed by Incubated, Infected and total\n"
+            "infections of each strain when there are several.")
+        .def_property_readonly(
+            "zone_stats",
+            [](const Model &self) {
+                const auto &stats = self.get_zone_stats();
+                size_t time = stats.size();
+                size_t zones = time == 0 ? 0 : stats[0].size() / 5;
+                py::array_t<int> array({time, zones, size_t(5)});
+                int *r = array.mutable_data();
+                for (const auto &day : stats) {
+                    // NOTE: A row of another width would overflow the array or misalign days
+                    if (day.size() != zones * 5) {
+                        throw std::runtime_error("Zone stats rows differ in width");
+                    }
+                    r = std::copy(day.begin(), day.end(), r);
+                }
+                return array;
+            },
+            "3D array of status counts per zone for each day (days, zones, 5).")
+        .def_property_readonly(
+            "metrics",
+            [](const Model &self) {
+                const auto &metrics = self.get_metrics();
+                size_t time = metrics.size();
+                py::array_t<double> array({time, static_cast<size_t>(METRIC_COUNT)});
+                auto r = array.mutable_unchecked<2>();
+                for (size_t i = 0; i < time; ++i) {
+                    for (size_t j = 0; j < static_cast<size_t>(METRIC_COUNT); ++j) {
+                        r(i, j) = metrics[i][j];
+                    }
+                }
+                return array;
+            },
+            "2D array of spatial metrics for each day: front distance, infectious clusters,\n"
+            "new infections and new infections per infector. Empty unless record.metrics is set.")
         .def_property_readonly("population", &Model::get_population, "Population being simulated.")
+        .def_property_readonly("record", &Model::get_policy, "Recording policy of the model.")
         .def_property_readonly("current_day", &Model::get_current_day, "Current simulation day.")
         .def_property_readonly("remain_days", &Model::get_remain_days, "Remaining simulation days.")
-        .def_property("name", &Model::get_name, &Model::set_name, "Name of the model.");
+        .def_property("name", &Model::get_name, &Model::set_name, "Name of the model.")
+        .def_property("verbose", &Model::get_verbose, &Model::set_verbose,
+                      "Whether simulate prints a progress bar.")
+        .def_property("pipeline_depth", &Model::get_pipeline_depth, &Model::set_pipeline_depth,
+                      "Frames stored on a background thread while the next day is computed.\n"
+                      "Recording waits once this many are in flight. 0 stores them inline.")
+        .def_property_readonly("frames_path", &Model::get_frames_path,
+                               "Binary frame file written while simulating, or empty.")
+        .def_property_readonly(
+            "memory", [](const Model &self) { return memory_dict(self.get_memory()); },
+            "Bytes held by the population and the recorded history, as a dict.")
+        .def_static(
+            "estimate_memory",
+            [](int days_in_simulation, const Population &population, const RecordPolicy &record) {
+                return memory_dict(Model::estimate_memory(days_in_simulation, population, record));
+            },
+            py::arg("days_in_simulation"), py::arg("population"), py::arg("record") = RecordPolicy(),
+            "Bytes a new Model would hold by the end of its run, without allocating it.\n"
+            "Returns:\n"
+            "    dict[str, int]: Bytes per part and their total.");
+
+    m.def(
+        "simulate_paired",
+        [](Model &baseline, Model &intervention, int days,
+           const std::shared_ptr<Schedule> &baseline_schedule,
+           const std::shared_ptr<Schedule> &intervention_schedule) {
+            py::gil_scoped_release release;
+            return simulate_paired(baseline, intervention, days, baseline_schedule,
+                                   intervention_schedule);
+        },
+        py::arg("baseline"), py::arg("intervention"), py::arg("days"),
+        py::arg("baseline_schedule") = nullptr, py::arg("intervention_schedule") = nullptr,
+        "Simulate two models in lockstep with common random numbers.\n"
+        "Both populations must use RandomMode.Keyed with the same seed and size, so every draw\n"
+        "is shared wherever their states agree and only the intervention separates them.\n"
+        "Args:\n"
+        "    baseline (Model): Model without the intervention.\n"
+        "    intervention (Model): Model with the intervention.\n"
+        "    days (int): Number of days to simulate, -1 for the rest.\n"
+        "    baseline_schedule (Schedule, optional): Parameter changes for the baseline.\n"
+        "    intervention_schedule (Schedule, optional): Parameter changes for the intervention.\n"
+        "Returns:\n"
+        "    bool: True if any day was simulated.\n"
+        "Raises:\n"
+        "    ValueError: If the populations cannot be paired or days is invalid.");
+
+    // Bind CalibrationSample struct
+    py::class_<CalibrationSample>(m, "CalibrationSample",
+                                  "Disease parameters of an accepted calibration candidate")
+        .def_readonly("transmission_rate", &CalibrationSample::transmission_rate,
+                      "Sampled transmission rate.")
+        .def_readonly("fatality_rate", &CalibrationSample::fatality_rate,
+                      "Sampled fatality rate.")
+        .def_readonly("days_in_incubation", &CalibrationSample::days_in_incubation,
+                      "Sampled days in incubation.")
+        .def_readonly("days_with_symptoms", &CalibrationSample::days_with_symptoms,
+                      "Sampled days with symptoms.")
+        .def_readonly("distance", &CalibrationSample::distance,
+                      "Sum of absolute differences to the observed series.");
+
+    // Bind Calibrator class
+    py::class_<Calibrator>(m, "Calibrator",
+                           "Approximate Bayesian calibration of Disease parameters")
+        .def(py::init([](const py::array_t<int, py::array::c_style | py::array::forcecast> &observed,
+                         double tolerance, int size, int travel_radius, int encounters,
+                         int init_incubations, int init_infections, Status status,
+                         unsigned int seed, int threads) {
+                 std::vector<int> series(observed.data(), observed.data() + observed.size());
+                 return Calibrator(series, tolerance, size, travel_radius, encounters,
+                                   init_incubations, init_infections, status, seed, threads);
+             }),
+             py::arg("observed"), py::arg("tolerance"), py::arg("size"), py::arg("travel_radius"),
+             py::arg("encounters"), py::arg("init_incubations"), py::arg("init_infections"),
+             py::arg("status") = Status::Infected, py::arg("seed") = 0, py::arg("threads") = 0,
+             "Initialize a Calibrator for an observed series.\n"
+             "Args:\n"
+             "    observed (np.ndarray): Observed count of the status for each day, day 0 first.\n"
+             "    tolerance (float): Largest accepted sum of absolute differences.\n"
+             "    size (int): Grid size of every candidate population.\n"
+             "    travel_radius (int): Travel radius of every candidate population.\n"
+             "    encounters (int): Encounters of every candidate population.\n"
+             "    init_incubations (int): Initial incubations of every candidate population.\n"
+             "    init_infections (int): Initial infections of every candidate population.\n"
+             "    status (Status, optional): Status the observed series counts.\n"
+             "    seed (int): Seed for parameter sampling and candidate populations.\n"
+             "    threads (int): Number of worker threads, 0 for all cores.\n"
+             "Raises:\n"
+             "    ValueError: If parameters are invalid.")
+        .def(
+            "run",
+            [](Calibrator &self, int candidates) {
+                py::gil_scoped_release release;
+                return self.run(candidates);
+            },
+            py::arg("candidates"),
+            "Sample and simulate candidates, rejecting each as soon as it exceeds the tolerance.\n"
+            "Args:\n"
+            "    candidates (int): Number of candidates to draw from the priors.\n"
+            "Returns:\n"
+            "    list[CalibrationSample]: Accepted samples in candidate order.\n"
+            "Raises:\n"
+            "    Exception: The first error of any worker, after every worker has stopped.")
+        .def("set_transmission_rate_prior", &Calibrator::set_transmission_rate_prior,
+             py::arg("low"), py::arg("high"), "Set the uniform prior of the transmission rate.")
+        .def("set_fatality_rate_prior", &Calibrator::set_fatality_rate_prior, py::arg("low"),
+             py::arg("high"), "Set the uniform prior of the fatality rate.")
+        .def("set_days_in_incubation_prior", &Calibrator::set_days_in_incubation_prior,
+             py::arg("low"), py::arg("high"), "Set the uniform prior of the days in incubation.")
+        .def("set_days_with_symptoms_prior", &Calibrator::set_days_with_symptoms_prior,
+             py::arg("low"), py::arg("high"), "Set the uniform prior of the days with symptoms.")
+        .def_property("tolerance", &Calibrator::get_tolerance, &Calibrator::set_tolerance,
+                      "Largest accepted distance (non-negative).")
+        .def_property("seed", &Calibrator::get_seed, &Calibrator::set_seed,
+                      "Seed for parameter sampling and candidate populations.")
+        .def_property("threads", &Calibrator::get_threads, &Calibrator::set_threads,
+                      "Number of worker threads, 0 for all cores.")
+        .def_property_readonly("rejected", &Calibrator::get_rejected,
+                               "Candidates rejected by the last run.")
+        .def_property_readonly("simulated_days", &Calibrator::get_simulated_days,
+                               "Days simulated over all candidates of the last run.");
+
+    // Bind Renderer class
+    py::class_<Renderer>(m, "Renderer",
+                         "Maps status grids through a color palette into RGB frames")
+        .def(py::init<int, int>(), py::arg("scale") = 1, py::arg("threads") = 0,
+             "Initialize a Renderer with the default palette.\n"
+             "Args:\n"
+             "    scale (int): Block size for majority downsampling (positive).\n"
+             "    threads (int): Number of worker threads, 0 for all cores.\n"
+             "Raises:\n"
+             "    ValueError: If parameters are invalid.")
+        .def(
+            "render",
+            [](const Renderer &self, const Model &model) {
+                int time = model.get_frame_count();
+                int height = model.get_frame_height();
+                int width = model.get_frame_width();
+                if (time == 0 || height == 0) {
+                    return py::array_t<uint8_t>(py::array::ShapeContainer{0, 0, 0, 3});
+                }
+                size_t out_height = self.get_output_height(height);
+                size_t out_width = self.get_output_width(width);
+                py::array_t<uint8_t> array({size_t(time), out_height, out_width, size_t(3)});
+                const uint8_t *in = model.get_frames().data();
+                uint8_t *out = array.mutable_data();
+                {
+                    py::gil_scoped_release release;
+                    self.render(in, time, height, width, out);
+                }
+                return array;
+            },
+            py::arg("model"),
+            "Render every recorded frame of a Model.\n"
+            "Returns:\n"
+            "    np.ndarray: uint8 RGB frames of shape (days, height, width, 3).")
+        .def("render", &render_array<uint8_t>, py::arg("data").noconvert(),
+             "Render a uint8 status grid (size, size) or stack (days, size, size).\n"
+             "Returns:\n"
+             "    np.ndarray: uint8 RGB frames of shape (..., height, width, 3).")
+        .def("render", &render_array<int>, py::arg("data"),
+             "Render a status grid (size, size) or stack (days, size, size).\n"
+             "Returns:\n"
+             "    np.ndarray: uint8 RGB frames of shape (..., height, width, 3).")
+        .def_property("palette", &Renderer::get_palette, &Renderer::set_palette,
+                      "RGB color for each status (Susceptible to Dead).")
+        .def_property("scale", &Renderer::get_scale, &Renderer::set_scale,
+                      "Block size for majority downsampling (positive).")
+        .def_property("threads", &Renderer::get_threads, &Renderer::set_threads,
+                      "Number of worker threads, 0 for all cores.");
 }
@@ -1,5 +1,30 @@
+from .calibrator import CalibrationSample, Calibrator
+from .class_table import ClassParameters, ClassTable
 from .disease import Disease
-from .model import Model
-from .population import Population
+from .model import Model, simulate_paired
+from .population import Population, RandomMode, Status
+from .record_policy import RecordPolicy
+from .renderer import Renderer
+from .schedule import Parameter, Schedule
+from .topology import Layout, Topology
+from .transmission_log import TransmissionLog
 
-__all__ = ["Disease", "Model", "Population"]
+__all__ = [
+    "CalibrationSample",
+    "Calibrator",
+    "ClassParameters",
+    "ClassTable",
+    "Disease",
+    "Layout",
+    "Model",
+    "Parameter",
+    "Population",
+    "RandomMode",
+    "RecordPolicy",
+    "Renderer",
+    "Schedule",
+    "Status",
+    "Topology",
+    "TransmissionLog",
+    "simulate_paired",
+]
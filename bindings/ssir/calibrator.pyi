@@ -0,0 +1,105 @@
+from nptyping import Int, NDArray, Shape
+from ssir.population import Status
+
+class CalibrationSample:
+    @property
+    def transmission_rate(self) -> float:
+        """Returns the sampled transmission rate."""
+        ...
+
+    @property
+    def fatality_rate(self) -> float:
+        """Returns the sampled fatality rate."""
+        ...
+
+    @property
+    def days_in_incubation(self) -> int:
+        """Returns the sampled days in incubation."""
+        ...
+
+    @property
+    def days_with_symptoms(self) -> int:
+        """Returns the sampled days with symptoms."""
+        ...
+
+    @property
+    def distance(self) -> float:
+        """Returns the sum of absolute differences to the observed series."""
+        ...
+
+class Calibrator:
+    def __init__(
+        self,
+        observed: NDArray[Shape["*, [days]"], Int],  # noqa: F722
+        tolerance: float,
+        size: int,
+        travel_radius: int,
+        encounters: int,
+        init_incubations: int,
+        init_infections: int,
+        status: Status = Status.Infected,
+        seed: int = 0,
+        threads: int = 0,
+    ) -> None:
+        """Initializes the Calibrator with an observed series and the candidate population setup."""
+        ...
+
+    def run(self, candidates: int) -> list[CalibrationSample]:
+        """Simulates candidates in parallel and returns the accepted samples in candidate order."""
+        ...
+
+    def set_transmission_rate_prior(self, low: float, high: float) -> None:
+        """Sets the uniform prior of the transmission rate."""
+        ...
+
+    def set_fatality_rate_prior(self, low: float, high: float) -> None:
+        """Sets the uniform prior of the fatality rate."""
+        ...
+
+    def set_days_in_incubation_prior(self, low: float, high: float) -> None:
+        """Sets the uniform prior of the days in incubation."""
+        ...
+
+    def set_days_with_symptoms_prior(self, low: float, high: float) -> None:
+        """Sets the uniform prior of the days with symptoms."""
+        ...
+
+    @property
+    def tolerance(self) -> float:
+        """Returns the largest accepted distance."""
+        ...
+
+    @property
+    def seed(self) -> int:
+        """Returns the seed for parameter sampling."""
+        ...
+
+    @property
+    def threads(self) -> int:
+        """Returns the number of worker threads (0 means all cores)."""
+        ...
+
+    @property
+    def rejected(self) -> int:
+        """Returns the number of candidates rejected by the last run."""
+        ...
+
+    @property
+    def simulated_days(self) -> int:
+        """Returns the days simulated over all candidates of the last run."""
+        ...
+
+    @tolerance.setter
+    def tolerance(self, tolerance: float) -> None:
+        """Sets the largest accepted distance."""
+        ...
+
+    @seed.setter
+    def seed(self, seed: int) -> None:
+        """Sets the seed for parameter sampling."""
+        ...
+
+    @threads.setter
+    def threads(self, threads: int) -> None:
+        """Sets the number of worker threads."""
+        ...
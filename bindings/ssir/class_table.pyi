@@ -0,0 +1,33 @@
+class ClassParameters:
+    susceptibility: float
+    fatality_rate: float
+    days_in_incubation: int
+    days_with_symptoms: int
+
+    def __init__(
+        self,
+        susceptibility: float,
+        fatality_rate: float,
+        days_in_incubation: int,
+        days_with_symptoms: int,
+    ) -> None:
+        """Initializes the parameters shared by every person of one class."""
+        ...
+
+class ClassTable:
+    def __init__(self, classes: list[ClassParameters]) -> None:
+        """Initializes the table from the parameters of each class (1 to 256)."""
+        ...
+
+    def __len__(self) -> int:
+        """Returns the number of classes."""
+        ...
+
+    def __getitem__(self, index: int) -> ClassParameters:
+        """Returns the parameters of a class."""
+        ...
+
+    @property
+    def classes(self) -> list[ClassParameters]:
+        """Returns the parameters of each class."""
+        ...
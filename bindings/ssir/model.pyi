@@ -1,27 +1,57 @@
-from nptyping import Int, NDArray, Shape
+from nptyping import Float, Int, NDArray, Shape
 from ssir.population import Population
+from ssir.record_policy import RecordPolicy
+from ssir.schedule import Schedule
 
 class Model:
-    def __init__(self, days_in_simulation: int, population: Population, name: str = "") -> None:
-        """Initializes the Model object with the population and simulation parameters."""
+    def __init__(
+        self,
+        days_in_simulation: int,
+        population: Population,
+        name: str = "",
+        record: RecordPolicy = ...,
+        memory_cap: int = 0,
+        frames_path: str = "",
+    ) -> None:
+        """Initializes the Model object, dropping the neighbor cache then frames if needed to fit memory_cap bytes."""
         ...
 
-    def simulate(self, days: int) -> NDArray[Shape["*, *, *, [days, size, size]"], Int]:  # noqa: F722
-        """Returns 3D numpy array of shape (days, size, size) representing infection state over time."""
+    def simulate(self, days: int, schedule: Schedule | None = None) -> bool:
+        """Simulates the given number of days, applying the schedule's changes inside the loop."""
         ...
 
     def reset(self, same_seed: bool = False) -> None:
-        """Reset model to its initial state."""
+        """Reset model to its initial state, undoing scheduled changes and re-arming their rules."""
         ...
 
     @property
     def data(self) -> NDArray[Shape["*, *, *, [days, size, size]"], Int]:  # noqa: F722
-        """3D numpy array of infection data over time (days, size, size)."""
+        """3D numpy array of infection data for each recorded day (frames, height, width)."""
         ...
 
     @property
-    def stats(self) -> NDArray[Shape["*, 5, [days, statuses]"], Int]:  # noqa: F722
-        """2D numpy array of shape (5, size) representing status counts over time."""
+    def frame_days(self) -> NDArray[Shape["*, [frames]"], Int]:  # noqa: F722
+        """1D numpy array with the day of each recorded frame."""
+        ...
+
+    @property
+    def stats(self) -> NDArray[Shape["*, *, [days, counts]"], Int]:  # noqa: F722
+        """2D numpy array of status counts over time, followed by 3 columns per strain when there are several."""
+        ...
+
+    @property
+    def zone_stats(self) -> NDArray[Shape["*, *, 5, [days, zones, statuses]"], Int]:  # noqa: F722
+        """3D numpy array of status counts per zone for each day (zones are set before the Model)."""
+        ...
+
+    @property
+    def metrics(self) -> NDArray[Shape["*, 4, [days, metrics]"], Float]:  # noqa: F722
+        """2D numpy array of [front distance, clusters, new infections, new infections per infector] per day."""
+        ...
+
+    @property
+    def record(self) -> RecordPolicy:
+        """Returns the recording policy of the model."""
         ...
 
     @property
@@ -44,7 +74,52 @@ class Model:
         """Returns the name of the model."""
         ...
 
+    @property
+    def verbose(self) -> bool:
+        """Returns whether simulate prints a progress bar."""
+        ...
+
+    @property
+    def pipeline_depth(self) -> int:
+        """Returns how many frames are stored on a background thread at once, 0 if inline."""
+        ...
+
+    @property
+    def frames_path(self) -> str:
+        """Returns the binary frame file written while simulating, or an empty string."""
+        ...
+
     @name.setter
     def name(self, name: str) -> None:
         """Sets the name of the model."""
         ...
+
+    @verbose.setter
+    def verbose(self, verbose: bool) -> None:
+        """Sets whether simulate prints a progress bar."""
+        ...
+
+    @pipeline_depth.setter
+    def pipeline_depth(self, depth: int) -> None:
+        """Sets how many frames are stored while the next day is computed, waiting once all are in flight."""
+        ...
+
+    @property
+    def memory(self) -> dict[str, int]:
+        """Returns the bytes held by the population and the recorded history, per part and in total."""
+        ...
+
+    @staticmethod
+    def estimate_memory(days_in_simulation: int, population: Population, record: RecordPolicy = ...) -> dict[str, int]:
+        """Returns the bytes a new Model would hold by the end of its run, without allocating it."""
+        ...
+
+def simulate_paired(
+    baseline: Model,
+    intervention: Model,
+    days: int,
+    baseline_schedule: Schedule | None = None,
+    intervention_schedule: Schedule | None = None,
+) -> bool:
+    """Simulates two keyed models on the same day and epoch in lockstep, sharing draws where states agree."""
+    ...
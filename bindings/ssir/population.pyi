@@ -1,7 +1,25 @@
-from nptyping import Int, NDArray, Shape
+from enum import IntEnum
+from typing import overload
+
+from nptyping import Bool, Int, NDArray, Shape, UInt8
+from ssir.class_table import ClassTable
 from ssir.disease import Disease
+from ssir.topology import Layout, Topology
+from ssir.transmission_log import TransmissionLog
+
+class Status(IntEnum):
+    Susceptible = 0
+    Incubated = 1
+    Infected = 2
+    Recovered = 3
+    Dead = 4
+
+class RandomMode(IntEnum):
+    Sequential = 0
+    Keyed = 1
 
 class Population:
+    @overload
     def __init__(
         self,
         size: int,
@@ -12,10 +30,27 @@ class Population:
         disease: Disease,
         seed: int = 0,
         name: str = "",
+        random_mode: RandomMode = RandomMode.Sequential,
+        memory_cap: int = 0,
     ) -> None:
         """Initializes the Population object with various parameters."""
         ...
 
+    @overload
+    def __init__(
+        self,
+        topology: Topology,
+        encounters: int,
+        init_incubations: int,
+        init_infections: int,
+        disease: Disease,
+        seed: int = 0,
+        name: str = "",
+        random_mode: RandomMode = RandomMode.Sequential,
+    ) -> None:
+        """Initializes a Population on a shared Topology, allocating only per-person state."""
+        ...
+
     def update(self) -> None:
         """Advances the simulation by one day."""
         ...
@@ -24,6 +59,186 @@ class Population:
         """Reset the population to its initial state."""
         ...
 
+    def vaccinate(self, cells: NDArray[Shape["*"], Int] | NDArray[Shape["*, *"], Bool]) -> int:  # noqa: F722
+        """Moves susceptible cells (flat indices or boolean mask) to Recovered, returns how many changed."""
+        ...
+
+    def seed_incubations(
+        self,
+        cells: NDArray[Shape["*"], Int] | NDArray[Shape["*, *"], Bool],  # noqa: F722
+        strain: int = 0,
+    ) -> int:
+        """Moves susceptible cells (flat indices or boolean mask) to Incubated with a strain, returns how many changed."""
+        ...
+
+    def isolate(self, cells: NDArray[Shape["*"], Int] | NDArray[Shape["*, *"], Bool], days: int) -> int:  # noqa: F722
+        """Removes cells (flat indices or boolean mask) from encounters for the given number of days."""
+        ...
+
+    def set_classes(self, classes: NDArray[Shape["*, *, [size, size]"], UInt8], table: ClassTable) -> None:  # noqa: F722
+        """Assigns a class to every cell, parameters come from the class table."""
+        ...
+
+    def load_classes(self, path: str, table: ClassTable) -> None:
+        """Assigns a class to every cell from a PGM raster of shape (size, size)."""
+        ...
+
+    def clear_classes(self) -> None:
+        """Drops the classes so every cell uses the Disease parameters again."""
+        ...
+
+    @property
+    def classes(self) -> NDArray[Shape["*, *, [size, size]"], UInt8] | None:  # noqa: F722
+        """2D uint8 numpy array of cell classes, or None."""
+        ...
+
+    @property
+    def class_table(self) -> ClassTable | None:
+        """Returns the parameters of each class, or None."""
+        ...
+
+    def set_layout(self, layout: Layout, tile: int = 16) -> None:
+        """Reorders the cells in memory, keeping every person's state and the results."""
+        ...
+
+    @property
+    def layout(self) -> Layout:
+        """Returns the order of cells in memory."""
+        ...
+
+    @property
+    def tile(self) -> int:
+        """Returns the tile size for Layout.Tiled."""
+        ...
+
+    @property
+    def random_mode(self) -> RandomMode:
+        """Returns how random draws are produced."""
+        ...
+
+    @random_mode.setter
+    def random_mode(self, value: RandomMode) -> None:
+        """Sets how random draws are produced, from the next draw on."""
+        ...
+
+    @property
+    def neighbor_cache(self) -> bool:
+        """Returns whether neighbor lists are precomputed."""
+        ...
+
+    @neighbor_cache.setter
+    def neighbor_cache(self, value: bool) -> None:
+        """Sets whether neighbor lists are precomputed, the same people are met either way."""
+        ...
+
+    @property
+    def batched(self) -> bool:
+        """Returns whether encounters are gathered and resolved grouped by target."""
+        ...
+
+    @batched.setter
+    def batched(self, value: bool) -> None:
+        """Sets whether encounters are resolved grouped by target, the same with keyed draws and a single strain."""
+        ...
+
+    @property
+    def topology(self) -> Topology:
+        """Returns the grid structure, shared until a setter gives this population its own copy."""
+        ...
+
+    @property
+    def memory(self) -> dict[str, int]:
+        """Returns the bytes held by each part of the population and their total."""
+        ...
+
+    @property
+    def state_memory(self) -> dict[str, int]:
+        """Returns the bytes held by the population without its topology."""
+        ...
+
+    @staticmethod
+    def estimate_memory(
+        size: int, travel_radius: int, neighbor_cache: bool = True, batched_encounters: int = 0
+    ) -> dict[str, int]:
+        """Returns the bytes a new population would hold, counting batched encounter buffers at peak."""
+        ...
+
+    def enable_transmission_log(self) -> None:
+        """Starts recording (infector cell, infectee cell, day) for every infection."""
+        ...
+
+    def disable_transmission_log(self) -> None:
+        """Stops recording infections and drops the log."""
+        ...
+
+    @property
+    def transmission_log(self) -> TransmissionLog | None:
+        """Returns the log of infections, or None when disabled."""
+        ...
+
+    @property
+    def day(self) -> int:
+        """Returns the number of updates since construction or reset."""
+        ...
+
+    def add_strain(self, disease: Disease, cross_immunity: float = 1.0) -> int:
+        """Adds a strain sharing the grid, returns its index. Protection with existing strains is cross_immunity."""
+        ...
+
+    def set_cross_immunity(self, source: int, target: int, protection: float) -> None:
+        """Sets how much recovering from the source strain protects against the target strain."""
+        ...
+
+    def get_cross_immunity(self, source: int, target: int) -> float:
+        """Returns how much recovering from the source strain protects against the target strain."""
+        ...
+
+    def strain(self, strain: int) -> Disease:
+        """Returns the parameters of a strain, 0 is the disease."""
+        ...
+
+    @property
+    def strain_count(self) -> int:
+        """Returns the number of strains."""
+        ...
+
+    @property
+    def strain_stats(self) -> NDArray[Shape["*, 3, [strains, counts]"], Int]:  # noqa: F722
+        """2D numpy array of Incubated, Infected and total infections for each strain."""
+        ...
+
+    @property
+    def strains(self) -> NDArray[Shape["*, *, [size, size]"], Int]:  # noqa: F722
+        """2D numpy array of the strain of each person's current or last infection, -1 if none."""
+        ...
+
+    def set_zones(self, zones: NDArray[Shape["*, *, [size, size]"], Int]) -> None:  # noqa: F722
+        """Assigns a zone label to every cell, status counts are then kept per zone."""
+        ...
+
+    def load_zones(self, path: str) -> None:
+        """Assigns a zone label to every cell from a PGM raster of shape (size, size)."""
+        ...
+
+    def clear_zones(self) -> None:
+        """Drops the zone labels."""
+        ...
+
+    @property
+    def zones(self) -> NDArray[Shape["*, *, [size, size]"], Int] | None:  # noqa: F722
+        """2D numpy array of cell zone labels, or None."""
+        ...
+
+    @property
+    def zone_count(self) -> int:
+        """Returns the number of zones."""
+        ...
+
+    @property
+    def zone_stats(self) -> NDArray[Shape["*, 5, [zones, statuses]"], Int]:  # noqa: F722
+        """2D numpy array of status counts for each zone."""
+        ...
+
     @property
     def people(self) -> NDArray[Shape["*, *, [size, size]"], Int]:  # noqa: F722
         """2D numpy array of shape (size, size), each cell is int representing status."""
@@ -50,6 +265,11 @@ class Population:
         """Returns the number of encounters per day."""
         ...
 
+    @property
+    def disease(self) -> Disease:
+        """Returns the disease spreading in the population, as given; strain(0) has scheduled overrides."""
+        ...
+
     @property
     def name(self) -> str:
         """Returns the name of the population."""
@@ -0,0 +1,66 @@
+class RecordPolicy:
+    def __init__(self) -> None:
+        """Initializes a policy recording a full frame every day."""
+        ...
+
+    @staticmethod
+    def full() -> RecordPolicy:
+        """Returns a policy recording a full frame every day."""
+        ...
+
+    @staticmethod
+    def stats_only() -> RecordPolicy:
+        """Returns a policy recording status counts only."""
+        ...
+
+    @staticmethod
+    def every(stride: int) -> RecordPolicy:
+        """Returns a policy recording a frame every stride-th day."""
+        ...
+
+    @staticmethod
+    def on_days(days: list[int]) -> RecordPolicy:
+        """Returns a policy recording frames only on the given days."""
+        ...
+
+    def set_region(self, row: int, col: int, height: int, width: int) -> None:
+        """Crops recorded frames to a region of interest."""
+        ...
+
+    def clear_region(self) -> None:
+        """Records the whole grid again."""
+        ...
+
+    def records(self, day: int) -> bool:
+        """Returns whether a frame is recorded on the given day."""
+        ...
+
+    @property
+    def frames(self) -> bool:
+        """Returns whether spatial frames are recorded."""
+        ...
+
+    @property
+    def metrics(self) -> bool:
+        """Returns whether spatial metrics are computed each day."""
+        ...
+
+    @metrics.setter
+    def metrics(self, metrics: bool) -> None:
+        """Sets whether spatial metrics are computed each day."""
+        ...
+
+    @property
+    def stride(self) -> int:
+        """Returns the frame stride in days."""
+        ...
+
+    @property
+    def days(self) -> list[int]:
+        """Returns the explicit recorded days."""
+        ...
+
+    @property
+    def region(self) -> tuple[int, int, int, int] | None:
+        """Returns the region of interest as (row, col, height, width)."""
+        ...
@@ -0,0 +1,49 @@
+from typing import overload
+
+from nptyping import Int, NDArray, Shape, UInt8
+from ssir.model import Model
+
+class Renderer:
+    def __init__(self, scale: int = 1, threads: int = 0) -> None:
+        """Initializes the Renderer object with the default palette."""
+        ...
+
+    @overload
+    def render(self, model: Model) -> NDArray[Shape["*, *, *, 3, [days, height, width, rgb]"], UInt8]:  # noqa: F722
+        """Returns uint8 RGB frames of shape (days, height, width, 3) for every recorded frame."""
+        ...
+
+    @overload
+    def render(self, data: NDArray[Shape["*, *, *, [days, size, size]"], Int]) -> NDArray[Shape["*, *, *, 3, [days, height, width, rgb]"], UInt8]:  # noqa: F722
+        """Returns uint8 RGB frames of shape (days, height, width, 3) for a stack of status grids."""
+        ...
+
+    @property
+    def palette(self) -> list[tuple[int, int, int]]:
+        """Returns the RGB color of each status (Susceptible to Dead)."""
+        ...
+
+    @property
+    def scale(self) -> int:
+        """Returns the block size used for majority downsampling."""
+        ...
+
+    @property
+    def threads(self) -> int:
+        """Returns the number of worker threads (0 means all cores)."""
+        ...
+
+    @palette.setter
+    def palette(self, palette: list[tuple[int, int, int]]) -> None:
+        """Sets the RGB color of each status."""
+        ...
+
+    @scale.setter
+    def scale(self, scale: int) -> None:
+        """Sets the block size used for majority downsampling."""
+        ...
+
+    @threads.setter
+    def threads(self, threads: int) -> None:
+        """Sets the number of worker threads."""
+        ...
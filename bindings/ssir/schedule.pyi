@@ -0,0 +1,44 @@
+from enum import IntEnum
+
+from ssir.population import Status
+
+class Parameter(IntEnum):
+    Encounters = 0
+    TravelRadius = 1
+    TransmissionRate = 2
+    FatalityRate = 3
+
+class Schedule:
+    def __init__(self) -> None:
+        """Initializes an empty Schedule."""
+        ...
+
+    def add_change(self, day: int, parameter: Parameter, value: float) -> None:
+        """Sets a parameter at the start of the given day."""
+        ...
+
+    def add_rule(
+        self,
+        status: Status,
+        threshold: int,
+        parameter: Parameter,
+        value: float,
+        above: bool = True,
+        once: bool = True,
+    ) -> None:
+        """Sets a parameter once the count of a status crosses a threshold."""
+        ...
+
+    def clear(self) -> None:
+        """Removes all changes and rules."""
+        ...
+
+    @property
+    def change_count(self) -> int:
+        """Returns the number of day-indexed changes."""
+        ...
+
+    @property
+    def rule_count(self) -> int:
+        """Returns the number of threshold rules."""
+        ...
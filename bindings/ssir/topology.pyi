@@ -0,0 +1,94 @@
+from enum import IntEnum
+
+from nptyping import Int, NDArray, Shape, UInt8
+from ssir.class_table import ClassTable
+
+class Layout(IntEnum):
+    RowMajor = 0
+    Morton = 1
+    Tiled = 2
+
+class Topology:
+    def __init__(
+        self,
+        size: int,
+        travel_radius: int,
+        layout: Layout = Layout.RowMajor,
+        tile: int = 16,
+        neighbor_cache: bool = True,
+    ) -> None:
+        """Initializes an immutable Topology, precomputing its neighbor table."""
+        ...
+
+    def with_travel_radius(self, radius: int) -> Topology:
+        """Returns a copy with another travel radius."""
+        ...
+
+    def with_layout(self, layout: Layout, tile: int = 16) -> Topology:
+        """Returns a copy with another cell order."""
+        ...
+
+    def with_neighbor_cache(self, enabled: bool) -> Topology:
+        """Returns a copy with or without the neighbor table."""
+        ...
+
+    def with_classes(self, classes: NDArray[Shape["*, *"], UInt8], table: ClassTable) -> Topology:  # noqa: F722
+        """Returns a copy with a class for every cell, sharing the neighbor table."""
+        ...
+
+    def without_classes(self) -> Topology:
+        """Returns a copy without classes."""
+        ...
+
+    def with_zones(self, zones: NDArray[Shape["*, *"], Int]) -> Topology:  # noqa: F722
+        """Returns a copy with a zone label for every cell, sharing the neighbor table."""
+        ...
+
+    def without_zones(self) -> Topology:
+        """Returns a copy without zones."""
+        ...
+
+    @property
+    def size(self) -> int:
+        """Returns the grid size (size x size)."""
+        ...
+
+    @property
+    def travel_radius(self) -> int:
+        """Returns the maximum encounter distance."""
+        ...
+
+    @property
+    def layout(self) -> Layout:
+        """Returns the order of cells in memory."""
+        ...
+
+    @property
+    def tile(self) -> int:
+        """Returns the tile size for Layout.Tiled."""
+        ...
+
+    @property
+    def neighbor_cache(self) -> bool:
+        """Returns whether the neighbor table is precomputed."""
+        ...
+
+    @property
+    def zone_count(self) -> int:
+        """Returns the number of zones."""
+        ...
+
+    @property
+    def class_table(self) -> ClassTable | None:
+        """Returns the parameters of each class, or None."""
+        ...
+
+    @property
+    def memory(self) -> dict[str, int]:
+        """Returns the bytes held by the topology and their total."""
+        ...
+
+    @staticmethod
+    def estimate_memory(size: int, travel_radius: int, neighbor_cache: bool = True) -> dict[str, int]:
+        """Returns the bytes a new topology would hold, without allocating it."""
+        ...
@@ -0,0 +1,22 @@
+from nptyping import NDArray, Shape, UInt32
+
+class TransmissionLog:
+    def __len__(self) -> int:
+        """Returns the number of recorded infections."""
+        ...
+
+    @property
+    def chunk_count(self) -> int:
+        """Returns the number of storage chunks."""
+        ...
+
+    def chunk(
+        self,
+        chunk: int,
+    ) -> tuple[NDArray[Shape["*"], UInt32], NDArray[Shape["*"], UInt32], NDArray[Shape["*"], UInt32]]:  # noqa: F722
+        """Returns zero-copy read-only (infector cells, infectee cells, days) views of one chunk."""
+        ...
+
+    def to_numpy(self) -> dict[str, NDArray[Shape["*"], UInt32]]:  # noqa: F722
+        """Copies the whole log into contiguous infector, infectee and day columns."""
+        ...
@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "scenario.h"
+
+static void print_usage(const char *program) {
+    std::cerr << "Usage: " << program << " [options] [scenario.ini ...]\n"
+              << "Options:\n"
+              << "  -m, --manifest <file>  Read scenario paths from a manifest, one per line\n"
+              << "  -j, --jobs <n>         Number of scenarios run at once (default: all cores)\n"
+              << "  -q, --quiet            Only report failures\n"
+              << "  -h, --help             Show this message\n";
+}
+
+static std::vector<std::string> read_manifest(const std::string &path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("Cannot open manifest file: " + path);
+    }
+
+    // NOTE: Scenario paths are relative to the manifest, like outputs are to their scenario
+    std::filesystem::path base = std::filesystem::path(path).parent_path();
+    std::vector<std::string> paths;
+    std::string line;
+    while (std::getline(file, line)) {
+        line = line.substr(0, line.find('#'));
+        line.erase(0, line.find_first_not_of(" \t\r"));
+        line.erase(line.find_last_not_of(" \t\r") + 1);
+        if (line.empty()) continue;
+        paths.push_back((base / line).string());
+    }
+    return paths;
+}
+
+int main(int argc, char **argv) {
+    std::vector<std::string> paths;
+    int jobs = 0;
+    bool quiet = false;
+
+    try {
+        for (int a = 1; a < argc; ++a) {
+            std::string arg = argv[a];
+            if (arg == "-h" || arg == "--help") {
+                print_usage(argv[0]);
+                return 0;
+            } else if (arg == "-q" || arg == "--quiet") {
+                quiet = true;
+            } else if ((arg == "-j" || arg == "--jobs") && a + 1 < argc) {
+                jobs = std::stoi(argv[++a]);
+            } else if ((arg == "-m" || arg == "--manifest") && a + 1 < argc) {
+                std::vector<std::string> listed = read_manifest(argv[++a]);
+                paths.insert(paths.end(), listed.begin(), listed.end());
+            } else if (!arg.empty() && arg[0] == '-') {
+                print_usage(argv[0]);
+                return 2;
+            } else {
+                paths.push_back(arg);
+            }
+        }
+    } catch (const std::exception &error) {
+        std::cerr << "error: " << error.what() << "\n";
+        return 2;
+    }
+
+    if (paths.empty() || jobs < 0) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    int workers = (jobs == 0) ? static_cast<int>(std::thread::hardware_concurrency()) : jobs;
+    workers = std::max(1, std::min(workers, static_cast<int>(paths.size())));
+
+    // Scenarios are independent, so workers simply pull the next unstarted one
+    std::atomic<int> next(0);
+    std::atomic<int> failed(0);
+    std::mutex output;
+    auto work = [&]() {
+        for (int s = next++; s < static_cast<int>(paths.size()); s = next++) {
+            auto start = std::chrono::steady_clock::now();
+            try {
+                Scenario::load(paths[s]).run();
+                if (!quiet) {
+                    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now() - start);
+                    std::lock_guard<std::mutex> lock(output);
+                    std::cout << "done " << paths[s] << " (" << elapsed.count() << " ms)\n";
+                }
+            } catch (const std::exception &error) {
+                failed += 1;
+                std::lock_guard<std::mutex> lock(output);
+                std::cerr << "failed " << paths[s] << ": " << error.what() << "\n";
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (int t = 1; t < workers; ++t) {
+        pool.emplace_back(work);
+    }
+    work();
+    for (auto &thread : pool) {
+        thread.join();
+    }
+
+    return failed == 0 ? 0 : 1;
+}
@@ -1,4 +1,4 @@
-from visualize import show_simulation
+from visualize import save_simulation
 from windows import import_module
 
 import_module("ssir.cp312-win_amd64.pyd")
@@ -28,4 +28,4 @@ model = Model(
 )
 
 model.simulate(days=200)
-show_simulation(model, save_path="simulation.gif", show=False)
+save_simulation(model, save_path="simulation.gif")
@@ -1,25 +1,48 @@
 import matplotlib.animation as animation
 import matplotlib.pyplot as plt
 import numpy as np
-from matplotlib.colors import ListedColormap
+from PIL import Image
 from windows import import_module
 
 import_module("ssir.cp312-win_amd64.pyd")
 
-from ssir import Model  # noqa: E402
+from ssir import Model, Renderer  # noqa: E402
+
+
+def load_frames(path: str) -> tuple[np.ndarray, np.ndarray]:
+    """Read a binary frame file written by ssir_run into (frame days, frames)."""
+    with open(path, "rb") as file:
+        if file.read(8) != b"SSIRFRM\0":
+            raise ValueError(f"Not a frame file: {path}")
+        version, count, height, width = (int(value) for value in np.frombuffer(file.read(16), dtype="<u4"))
+        # Version 2 reserves a day table of capacity entries so frames can be streamed after it
+        capacity = int(np.frombuffer(file.read(4), dtype="<u4")[0]) if version >= 2 else count
+        days = np.frombuffer(file.read(4 * capacity), dtype="<i4")[:count]
+        frames = np.frombuffer(file.read(count * height * width), dtype=np.uint8)
+        frames = frames.reshape(count, height, width)
+    return days, frames
+
+
+def save_simulation(model: Model, save_path: str, scale: int = 1, fps: int = 5) -> None:
+    """Render the grid frames natively and encode them straight into an animation."""
+    frames = Renderer(scale=scale).render(model)
+    images = [Image.fromarray(frame) for frame in frames]
+    images[0].save(save_path, save_all=True, append_images=images[1:], duration=1000 // fps, loop=0)
+    print(f"Saved animation to {save_path}")
 
 
 def show_simulation(model: Model, save_path: str | None = None, show: bool = True) -> animation.FuncAnimation:
     """Visualize the simulation with grid and status counts."""
     data = model.data
-    stats = model.stats
+    frame_days = model.frame_days
+    stats = model.stats[frame_days, :5]  # Per-strain columns follow the status counts
     days, size, _ = data.shape
     if stats.shape != (days, 5):
         raise ValueError("Stats shape mismatch")
 
     # Color scheme
     colors = ["#D3D3D3", "#FF69B4", "#FF0000", "#228B22", "#333333"]  # Light Gray, Pink, Red, Forest Green, Light Black
-    cmap = ListedColormap(colors)
+    frames = Renderer().render(data)
 
     # Dark theme setup
     plt.style.use("dark_background")
@@ -27,7 +50,7 @@ def show_simulation(model: Model, save_path: str | None = None, show: bool = Tru
     fig.suptitle(f"Simulation of {model.name}", color="white")
 
     # Grid plot
-    im = ax1.imshow(data[0], cmap=cmap, vmin=0, vmax=4)
+    im = ax1.imshow(frames[0])
     ax1.axis("off")
     title = ax1.set_title("Day 0", color="white", fontsize=12, pad=10)
     ax1.set_facecolor("#2D2D2D")
@@ -43,8 +66,8 @@ def show_simulation(model: Model, save_path: str | None = None, show: bool = Tru
     ax2.grid(True, axis="y", color="gray", linestyle="--", alpha=0.5)
 
     def update(frame: int) -> list:
-        im.set_data(data[frame])
-        title.set_text(f"Day {frame}")
+        im.set_data(frames[frame])
+        title.set_text(f"Day {frame_days[frame]}")
         plt.draw()
         for rect, h in zip(bar_container, stats[frame], strict=False):
             rect.set_height(h)
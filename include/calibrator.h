@@ -0,0 +1,86 @@
+#ifndef CALIBRATOR_H
+#define CALIBRATOR_H
+
+#include <memory>
+#include <vector>
+
+#include "person.h"
+#include "topology.h"
+
+/**
+ * @brief Uniform prior range of a calibrated parameter
+ * */
+struct Prior {
+    double low = 0.0;   ///< Lower bound (inclusive)
+    double high = 0.0;  ///< Upper bound (inclusive)
+};
+
+/**
+ * @brief Disease parameters of an accepted candidate and its distance to the observed series
+ * */
+struct CalibrationSample {
+    double transmission_rate = 0.0;  ///< Sampled transmission rate
+    double fatality_rate = 0.0;      ///< Sampled fatality rate
+    int days_in_incubation = 0;      ///< Sampled days in incubation
+    int days_with_symptoms = 0;      ///< Sampled days with symptoms
+    double distance = 0.0;           ///< Sum of absolute differences to the observed series
+};
+
+/**
+ * @class Calibrator
+ * @brief Approximate Bayesian calibration of Disease parameters against an observed series
+ * */
+class Calibrator {
+   private:
+    std::vector<int> observed;         ///< Observed counts for each day, day 0 first
+    double tolerance = 0.0;            ///< Largest accepted distance
+    Status status = Status::Infected;  ///< Status the observed series counts
+    int size = 1;                      ///< Grid size of every candidate population
+    int travel_radius = 1;             ///< Travel radius of every candidate population
+    int encounters = 1;                ///< Encounters of every candidate population
+    int init_incubations = 1;          ///< Initial incubations of every candidate population
+    int init_infections = 0;           ///< Initial infections of every candidate population
+    unsigned int seed = 0;             ///< Seed for parameter sampling and candidate populations
+    int threads = 0;                   ///< Number of worker threads (0 means hardware concurrency)
+
+    Prior transmission_rate = {0.0, 1.0};    ///< Prior of the transmission rate
+    Prior fatality_rate = {0.0, 0.1};        ///< Prior of the fatality rate
+    Prior days_in_incubation = {1.0, 14.0};  ///< Prior of the days in incubation
+    Prior days_with_symptoms = {1.0, 21.0};  ///< Prior of the days with symptoms
+
+    int rejected = 0;              ///< Candidates rejected by the last run
+    long long simulated_days = 0;  ///< Days simulated over all candidates of the last run
+
+   public:
+    Calibrator(const std::vector<int> &observed, double tolerance, int size, int travel_radius,
+               int encounters, int init_incubations, int init_infections,
+               Status status = Status::Infected, unsigned int seed = 0, int threads = 0);
+
+    std::vector<CalibrationSample> run(int candidates);
+
+    Prior get_transmission_rate_prior() const;
+    Prior get_fatality_rate_prior() const;
+    Prior get_days_in_incubation_prior() const;
+    Prior get_days_with_symptoms_prior() const;
+    double get_tolerance() const;
+    unsigned int get_seed() const;
+    int get_threads() const;
+    int get_rejected() const;
+    long long get_simulated_days() const;
+
+    void set_transmission_rate_prior(double low, double high);
+    void set_fatality_rate_prior(double low, double high);
+    void set_days_in_incubation_prior(double low, double high);
+    void set_days_with_symptoms_prior(double low, double high);
+    void set_tolerance(double tolerance);
+    void set_seed(unsigned int seed);
+    void set_threads(int threads);
+
+   private:
+    void validate() const;
+
+    bool evaluate(int candidate, const std::shared_ptr<const Topology> &topology,
+                  CalibrationSample &sample, int &days) const;
+};
+
+#endif
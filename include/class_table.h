@@ -0,0 +1,35 @@
+#ifndef CLASS_TABLE_H
+#define CLASS_TABLE_H
+
+#include <vector>
+
+/**
+ * @brief Disease parameters shared by every person of one class (e.g. an age or risk group)
+ * */
+struct ClassParameters {
+    double susceptibility = 1.0;  ///< Multiplier on the chance of being infected (non-negative)
+    double fatality_rate = 0.0;   ///< Probability of fatal outcome (0 to 1)
+    int days_in_incubation = 0;   ///< Number of days in incubation period
+    int days_with_symptoms = 0;   ///< Number of days with symptoms
+};
+
+/**
+ * @class ClassTable
+ * @brief Small table of per-class parameters indexed by a uint8 class per cell
+ * */
+class ClassTable {
+   private:
+    std::vector<ClassParameters> classes;  ///< Parameters of each class, indexed by class id
+
+   public:
+    ClassTable(const std::vector<ClassParameters> &classes);
+
+    const ClassParameters &get(int index) const;
+    const std::vector<ClassParameters> &get_classes() const;
+    int get_size() const;
+
+   private:
+    void validate() const;
+};
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef FRAME_PIPELINE_H
+#define FRAME_PIPELINE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class FramePipeline
+ * @brief Hands recorded frames to a background thread through a fixed ring of buffers
+ *
+ * The simulation fills the next free buffer from acquire() and passes it on with submit(), then
+ * computes the next day while the worker stores the frame. Once every buffer is in flight,
+ * acquire() waits for the worker, so memory stays bounded however slow the sink is. Once the sink
+ * fails, the pipeline stays failed: every later call rethrows the error and no frame is stored.
+ * */
+class FramePipeline {
+   public:
+    using Sink = std::function<void(int day, const uint8_t *frame)>;
+
+   private:
+    size_t frame_size = 0;                      ///< Bytes of each frame
+    Sink sink;                                  ///< Stores one frame, called on the worker thread
+    std::vector<std::vector<uint8_t>> buffers;  ///< Ring of frame buffers
+    std::vector<int> days;                      ///< Day of the frame in each buffer
+    size_t submitted = 0;                       ///< Frames handed to the worker so far
+    size_t stored = 0;                          ///< Frames the worker has finished with
+    bool stopping = false;                      ///< Whether the worker exits once drained
+    std::exception_ptr error;                   ///< First failure of the sink, null if none
+    std::mutex mutex;                           ///< Guards the counters, flags and error
+    std::condition_variable submitted_frame;    ///< Wakes the worker when a frame is submitted
+    std::condition_variable stored_frame;       ///< Wakes the simulation when a buffer is free
+    std::thread worker;                         ///< Background thread running the sink
+
+   public:
+    FramePipeline(size_t frame_size, int depth, Sink sink);
+    FramePipeline(const FramePipeline &) = delete;
+    FramePipeline &operator=(const FramePipeline &) = delete;
+    ~FramePipeline();
+
+    uint8_t *acquire();
+    void submit(int day);
+    void flush();
+
+    int get_depth() const;
+    size_t get_frame_size() const;
+
+   private:
+    void run();
+    void rethrow();
+};
+
+#endif
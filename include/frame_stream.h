@@ -0,0 +1,57 @@
+#ifndef FRAME_STREAM_H
+#define FRAME_STREAM_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Magic bytes at the start of every binary frame file
+ * */
+constexpr char FRAMES_MAGIC[8] = {'S', 'S', 'I', 'R', 'F', 'R', 'M', '\0'};
+
+/**
+ * @brief Version of the binary frame file layout
+ * */
+constexpr unsigned int FRAMES_VERSION = 2;
+
+/**
+ * @class FrameStream
+ * @brief Appends status frames to a binary frame file as they are recorded
+ *
+ * Layout: magic, then uint32 version, frames, height, width, capacity, then the int32 day of each
+ * of capacity frames (0 past the last frame), then one uint8 status per cell, frame by frame.
+ * Version 1 had no capacity and exactly frames days. The day table is sized up front, so frames
+ * are appended in place, and the header is rewritten on every flush to keep the file complete.
+ * */
+class FrameStream {
+   private:
+    std::string path;           ///< Path of the frame file
+    std::ofstream file;         ///< Open frame file, positioned after the last frame
+    int height = 0;             ///< Rows of each frame
+    int width = 0;              ///< Columns of each frame
+    int capacity = 0;           ///< Frames the day table has room for
+    std::vector<int32_t> days;  ///< Day of each frame written so far
+
+   public:
+    FrameStream(const std::string &path, int height, int width, int capacity);
+    FrameStream(const FrameStream &) = delete;
+    FrameStream &operator=(const FrameStream &) = delete;
+
+    void write(int day, const uint8_t *frame);
+    void flush();
+    void clear();
+
+    const std::string &get_path() const;
+    int get_frame_count() const;
+    int get_height() const;
+    int get_width() const;
+    int get_capacity() const;
+
+   private:
+    void open();
+    std::streamoff get_frames_end() const;
+};
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef LAYOUT_H
+#define LAYOUT_H
+
+#include <vector>
+
+/**
+ * @brief Enum class representing the order in which grid cells are stored in memory
+ *
+ * Results for a given seed do not depend on the layout. Tiled is the one to try for speed, Morton
+ * has not measured faster than row-major.
+ * */
+enum class Layout {
+    RowMajor = 0,  ///< Row after row, the order cells are indexed in
+    Morton,        ///< Z-order curve
+    Tiled,         ///< Square tiles in row-major order, row-major inside each tile
+};
+
+std::vector<int> order_cells(int size, Layout layout, int tile = 16);
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef MEMORY_H
+#define MEMORY_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @struct MemoryUsage
+ * @brief Bytes held by each part of a Population or Model, from capacities not sizes
+ * */
+struct MemoryUsage {
+    size_t people = 0;      ///< Person grid
+    size_t neighbors = 0;   ///< Precomputed neighbor table, 0 when sampled on the fly
+    size_t infectious = 0;  ///< Infectious, isolated and newly infected lists
+    size_t tables = 0;      ///< Cell order, classes, zones and strain tables
+    size_t log = 0;         ///< Transmission log chunks
+    size_t history = 0;     ///< Recorded frames, stats, metrics and zone stats
+
+    size_t total() const;
+    std::string describe() const;
+};
+
+std::string format_bytes(size_t bytes);
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <utility>
+#include <vector>
+
+#include "population.h"
+
+/**
+ * @brief Number of per-day spatial metric columns
+ * */
+constexpr int METRIC_COUNT = 4;
+
+/**
+ * @class SpatialMetrics
+ * @brief Epidemic front, cluster count and reproduction estimate computed from changed cells
+ *
+ * Columns are [front distance, infectious clusters, new infections, new infections per infector].
+ * Every day's cost is proportional to the infectious and newly infected cells, not the grid:
+ * clusters are recounted over the infectious cells each day, as union-find cannot undo recoveries.
+ * Seeds are the carriers that appear without being infected by an encounter, whenever seeded.
+ * */
+class SpatialMetrics {
+   private:
+    int size = 1;                            ///< Grid size (size x size)
+    std::vector<std::pair<int, int>> seeds;  ///< Positions of carriers seeded rather than infected
+    double front = 0.0;                      ///< Farthest distance from a seed reached so far
+    std::vector<int> parent;                 ///< Union-find parent of each cell, -1 if inactive
+    std::vector<int> last_seen;  ///< Last measure in which each cell was a carrier, -2 if never
+    int tick = 0;                ///< Number of measures taken so far
+
+   public:
+    SpatialMetrics(const Population &population);
+
+    std::vector<double> measure(const Population &population);
+
+   private:
+    int count_clusters(const std::vector<Person *> &infectious);
+    int find(int cell);
+};
+
+#endif
@@ -1,11 +1,19 @@
 #ifndef MODEL_H
 #define MODEL_H
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "frame_pipeline.h"
+#include "frame_stream.h"
+#include "memory.h"
+#include "metrics.h"
 #include "population.h"
+#include "record_policy.h"
+#include "schedule.h"
 
 /**
  * @class Model
@@ -18,30 +26,76 @@ class Model {
     int days_in_simulation = 1;              ///< Total days of the entire simulation
     std::shared_ptr<Population> population;  ///< Shared pointer to population being simulated
     std::string name = "";                   ///< Name of the model
+    RecordPolicy policy;                     ///< Which frames are recorded and how they are cropped
+    bool verbose = true;                     ///< Whether simulate prints a progress bar
 
-    std::vector<std::vector<std::vector<int>>>
-        data;                             ///< 3D vector of population states for each day
-    std::vector<std::vector<int>> stats;  ///< 2D vector of status counts for each day
+    std::vector<uint8_t> frames;               ///< Statuses of each recorded day, frame after frame
+    int frame_height = 0;                      ///< Rows of each recorded frame
+    int frame_width = 0;                       ///< Columns of each recorded frame
+    std::vector<int> frame_days;               ///< Day of each recorded frame
+    std::vector<std::vector<int>> stats;       ///< 2D vector of status counts for each day
+    std::vector<std::vector<double>> metrics;  ///< 2D vector of spatial metrics for each day
+    std::vector<std::vector<int>> zone_stats;  ///< Status counts per zone (zones x 5) for each day
+    int zone_count = 0;                        ///< Zones the population had when recording began
+    std::unique_ptr<SpatialMetrics> tracker;   ///< Computes metrics when the policy asks for them
+
+    std::vector<std::shared_ptr<Schedule>> schedules;  ///< Schedules applied since the last reset
+    std::vector<std::vector<bool>> fired;  ///< Rules of each schedule this model has fired
+    int unscheduled_encounters = 0;     ///< Encounters before the first scheduled change
+    int unscheduled_travel_radius = 0;  ///< Travel radius before the first scheduled change
+
+    std::unique_ptr<FrameStream> stream;  ///< Frame file written day by day, null to keep frames
+    std::vector<uint8_t> frame_buffer;    ///< Frame gathered for the stream without a pipeline
+    // NOTE: Declared last so its worker is joined before anything it stores into is destroyed
+    std::unique_ptr<FramePipeline> pipeline;  ///< Stores frames on a background thread, or null
 
    public:
     Model(int days_in_simulation, std::shared_ptr<Population> population,
-          const std::string &name = "");
+          const std::string &name = "", const RecordPolicy &policy = RecordPolicy(),
+          size_t memory_cap = 0, const std::string &frames_path = "");
+    Model(const Model &) = delete;
+    Model &operator=(const Model &) = delete;
 
-    bool simulate(int days);
+    bool simulate(int days, const std::shared_ptr<Schedule> &schedule = nullptr);
     void reset(bool same_seed = false);
 
-    const std::vector<std::vector<std::vector<int>>> &get_data() const;
+    std::vector<std::vector<std::vector<int>>> get_data() const;
+    const std::vector<uint8_t> &get_frames() const;
+    int get_frame_count() const;
+    int get_frame_height() const;
+    int get_frame_width() const;
+    const std::vector<int> &get_frame_days() const;
     const std::vector<std::vector<int>> &get_stats() const;
+    const std::vector<std::vector<double>> &get_metrics() const;
+    const std::vector<std::vector<int>> &get_zone_stats() const;
+    const RecordPolicy &get_policy() const;
     std::shared_ptr<Population> get_population() const;
     int get_remain_days() const;
     int get_current_day() const;
     std::string get_name() const;
+    bool get_verbose() const;
+    int get_pipeline_depth() const;
+    std::string get_frames_path() const;
+    MemoryUsage get_memory() const;
 
     void set_name(const std::string &name);
+    void set_verbose(bool verbose);
+    void set_pipeline_depth(int depth);
+
+    static MemoryUsage estimate_memory(int days_in_simulation, const Population &population,
+                                       const RecordPolicy &policy);
 
    private:
+    void fit_memory(size_t memory_cap, bool streaming);
+    void record(int day);
+    void store_frame(int day, const uint8_t *frame);
+    void flush_frames();
 };
 
+bool simulate_paired(Model &baseline, Model &intervention, int days,
+                     const std::shared_ptr<Schedule> &baseline_schedule = nullptr,
+                     const std::shared_ptr<Schedule> &intervention_schedule = nullptr);
+
 void print_progress_bar(int progress, int total, int bar_width = 50);
 
 #endif
@@ -1,9 +1,12 @@
 #ifndef PERSON_H
 #define PERSON_H
 
-#include <random>
+#include <cstdint>
+#include <utility>
 
+#include "class_table.h"
 #include "disease.h"
+#include "random.h"
 
 /**
  * @brief Enum class representing the disease status of a person
@@ -25,28 +28,36 @@ class Person {
     Status status = Status::Susceptible;  ///< Current disease status
     int remain_incubated_days = -1;       ///< Remaining days in incubation period
     int remain_infected_days = -1;        ///< Remaining days with symptoms
+    int remain_isolated_days = 0;         ///< Remaining days excluded from encounters
+    int strain = -1;                      ///< Strain of the current or last infection, -1 if none
+    uint32_t immunity = 0;                ///< Bit per strain recovered from, all set if vaccinated
     int i;                                ///< The row coordinate in grid
     int j;                                ///< The col coordinate in grid
 
    public:
     Person(int i, int j);
 
-    bool incubate(int days_in_incubation);
+    bool incubate(int days_in_incubation, int strain = 0);
+    bool reinfect(int days_in_incubation, int strain);
     bool infect(int days_with_symptoms);
     bool recover();
     bool die();
-    void update(const Disease *disease, std::mt19937 &rng);
+    bool vaccinate();
+    bool isolate(int days);
+    bool update_isolation();
+    void update(const Disease *disease, Random &random, int day, int cell,
+                const ClassParameters *parameters = nullptr);
 
     bool is_susceptible() const;
     bool is_infectious() const;
     bool is_removed() const;
+    bool is_isolated() const;
 
     Status get_status() const;
+    int get_strain() const;
+    uint32_t get_immunity() const;
     char get_symbol() const;
     std::pair<int, int> get_position() const;
-
-   private:
-    double get_chance(std::mt19937 &rng) const;
 };
 
 #endif
@@ -1,13 +1,22 @@
 #ifndef POPULATION_H
 #define POPULATION_H
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
-#include <random>
 #include <string>
 #include <vector>
 
+#include "class_table.h"
 #include "disease.h"
+#include "layout.h"
+#include "memory.h"
 #include "person.h"
+#include "random.h"
+#include "topology.h"
+#include "transmission_log.h"
+
+constexpr int MAX_STRAINS = 32;  ///< Strains that fit in a Person's immunity bits
 
 /**
  * @class Population
@@ -15,52 +24,156 @@
  * */
 class Population {
    private:
-    int size = 1;                      ///< Grid size (size x size)
-    int travel_radius = 1;             ///< Maximum encounter distance
-    int encounters = 1;                ///< Number of encounters per person
-    int init_incubations = 1;          ///< Initial number of incubated people for reset logic
-    int init_infections = 0;           ///< Initial number of infected people for reset logic
-    unsigned int seed = 0;             ///< Seed for the RNG
-    std::string name = "";             ///< Name of the population
-    std::shared_ptr<Disease> disease;  ///< Disease parameters
-    mutable std::mt19937 rng;          ///< Random number generator
+    /**
+     * @brief One encounter of a batched update, grouped by target before it is resolved
+     * */
+    struct Encounter {
+        uint32_t target;  ///< Storage slot of the person met
+        uint32_t cell;    ///< Row-major cell of the carrier
+        uint32_t index;   ///< Encounter number of the carrier, keys its transmission draw
+        uint32_t strain;  ///< Strain of the carrier
+    };
+
+    int size = 1;                              ///< Grid size (size x size), as in the topology
+    int encounters = 1;                        ///< Number of encounters per person
+    int init_incubations = 1;                  ///< Initial number of incubated people for reset
+    int init_infections = 0;                   ///< Initial number of infected people for reset
+    unsigned int seed = 0;                     ///< Seed for the RNG
+    std::string name = "";                     ///< Name of the population
+    std::shared_ptr<Disease> disease;          ///< Disease parameters (strain 0)
+    mutable Random random;                     ///< Random number generator
+    std::shared_ptr<const Topology> topology;  ///< Grid structure, possibly shared
 
     std::vector<int> status_count = std::vector<int>(5, 0);    ///< Counts of each Status
     std::vector<Person *> infectious_people;                   ///< Keep track of infectious people
-    std::vector<std::vector<std::unique_ptr<Person>>> people;  ///< 2D grid of Persons
-    std::vector<std::vector<std::vector<Person *>>>
-        neighbors;  ///< Precomputed neighbors for each person
+    std::vector<Person *> isolated_people;                     ///< Keep track of isolated people
+    std::vector<Person *> new_infections;  ///< People infected by encounters in the last update
+    int infectors = 0;                     ///< People who made encounters in the last update
+    int day = 0;                           ///< Number of updates since construction or reset
+    std::shared_ptr<TransmissionLog> transmission_log;  ///< Who infected whom, null if disabled
+    std::vector<Person> people;                         ///< Grid of Persons, in topology order
+    std::vector<int> zone_counts;                       ///< Status counts per zone (zones x 5)
+    bool batched = false;                   ///< Resolve encounters grouped by target
+    std::vector<Encounter> encounter_list;  ///< Encounters of the day, reused between updates
+    std::vector<Encounter> encounter_swap;  ///< Scratch space for sorting encounters
+
+    // NOTE: Strain 0 becomes a private copy of disease once this population overrides a rate
+    std::vector<std::shared_ptr<Disease>> strains;  ///< Parameters of each strain, 0 is disease
+    std::vector<double> cross_immunity;  ///< Protection from row strain against column (n x n)
+    std::vector<int> strain_counts;      ///< Incubated, Infected, total infections per strain
 
    public:
     Population(int size, int travel_radius, int encounters, int init_incubations,
                int init_infections, std::shared_ptr<Disease> disease, unsigned int seed = 0,
-               const std::string &name = "");
+               const std::string &name = "", RandomMode random_mode = RandomMode::Sequential,
+               size_t memory_cap = 0);
+    Population(std::shared_ptr<const Topology> topology, int encounters, int init_incubations,
+               int init_infections, std::shared_ptr<Disease> disease, unsigned int seed = 0,
+               const std::string &name = "", RandomMode random_mode = RandomMode::Sequential);
+    Population(const Population &) = delete;
+    Population &operator=(const Population &) = delete;
 
     void update();
     void reset(bool same_seed = false);
 
+    int vaccinate(const std::vector<int> &cells);
+    int seed_incubations(const std::vector<int> &cells, int strain = 0);
+    int isolate(const std::vector<int> &cells, int days);
+
+    void set_classes(const std::vector<uint8_t> &classes, std::shared_ptr<ClassTable> table);
+    void load_classes(const std::string &path, std::shared_ptr<ClassTable> table);
+    void clear_classes();
+
+    void set_zones(const std::vector<int> &zones);
+    void load_zones(const std::string &path);
+    void clear_zones();
+
+    void set_layout(Layout layout, int tile = 16);
+    void set_random_mode(RandomMode mode);
+    void set_neighbor_cache(bool enabled);
+    void set_batched(bool enabled);
+
+    int add_strain(std::shared_ptr<Disease> disease, double cross_immunity = 1.0);
+    void set_cross_immunity(int from, int to, double protection);
+
+    void enable_transmission_log();
+    void disable_transmission_log();
+
     std::vector<std::vector<int>> get_people() const;
+    std::vector<std::vector<int>> get_people(int row, int col, int height, int width) const;
+    std::vector<std::vector<int>> get_strain_grid() const;
+    void copy_statuses(uint8_t *out, int row, int col, int height, int width) const;
     const std::vector<int> &get_status_count() const;
+    const std::vector<Person *> &get_infectious_people() const;
+    const std::vector<Person *> &get_new_infections() const;
+    int get_infectors() const;
+    int get_day() const;
+    std::shared_ptr<TransmissionLog> get_transmission_log() const;
+    std::shared_ptr<const Topology> get_topology() const;
     int get_size() const;
     int get_travel_radius() const;
     int get_encounters() const;
+    std::shared_ptr<Disease> get_disease() const;
+    int get_strain_count() const;
+    std::shared_ptr<Disease> get_strain(int strain) const;
+    double get_cross_immunity(int from, int to) const;
+    const std::vector<int> &get_strain_counts() const;
+    const std::vector<int> &get_zones() const;
+    int get_zone_count() const;
+    const std::vector<int> &get_zone_counts() const;
+    const std::vector<uint8_t> &get_classes() const;
+    std::shared_ptr<ClassTable> get_class_table() const;
+    Layout get_layout() const;
+    int get_tile() const;
+    RandomMode get_random_mode() const;
+    uint64_t get_random_epoch() const;
+    bool get_neighbor_cache() const;
+    bool get_batched() const;
+    MemoryUsage get_memory(bool include_topology = true) const;
     std::string get_name() const;
     unsigned int get_seed() const;
 
     void set_travel_radius(int radius);
     void set_encounters(int encounters);
+    void set_transmission_rate(double rate);
+    void set_fatality_rate(double rate);
+    void clear_disease_overrides();
     void set_name(const std::string &name);
     void set_seed(unsigned int seed);
 
+    static MemoryUsage estimate_memory(int size, int travel_radius, bool neighbor_cache = true,
+                                       int batched_encounters = 0);
+
    private:
     void validate() const;
+    void validate_cells(const std::vector<int> &cells) const;
+
+    Person *at(int cell);
+    const Person *at(int cell) const;
+    int cell_of(const Person *person) const;
+    void count_transition(const Person *person, Status from, Status to);
+    void count_zones();
+    void count_strains();
+    void validate_strain(int strain) const;
+    Disease &override_disease();
+    void update_isolation();
+    void build_people();
+    void set_topology(std::shared_ptr<const Topology> topology);
+
+    const ClassParameters *get_parameters(const Person *person) const;
+    int get_days_in_incubation(const Person *person, int strain = 0) const;
+    int get_days_with_symptoms(const Person *person, int strain = 0) const;
+    double get_protection(const Person *person, int strain) const;
 
-    std::vector<Person *> flatten() const;
-    std::vector<Person *> sample(std::vector<Person *> people, int count) const;
+    std::vector<Person *> flatten();
+    std::vector<Person *> sample(const std::vector<Person *> &people, int count, Purpose purpose,
+                                 int cell = 0) const;
 
-    std::vector<Person *> get_encountered(int row, int col) const;
-    bool interact(Person *current, Person *other);
-    double get_chance(std::mt19937 &rng) const;
+    void get_encountered(const Person *person, std::vector<Person *> &targets);
+    bool interact(Person *current, Person *other, uint32_t index);
+    void spread();
+    void spread_batched();
+    void sort_encounters();
 };
 
 #endif
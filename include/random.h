@@ -0,0 +1,56 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+#include <random>
+
+/**
+ * @brief Enum class representing how random draws are produced
+ * */
+enum class RandomMode {
+    Sequential = 0,  ///< One stream consumed in order, any change shifts every later draw
+    Keyed,           ///< Each draw hashed from its key, shared by runs whose states agree
+};
+
+/**
+ * @brief Enum class representing what a random draw decides, part of its key
+ * */
+enum class Purpose : uint32_t {
+    Incubation = 0,  ///< Picking the initially incubated people
+    Infection,       ///< Picking the initially infected among them
+    Fatality,        ///< Whether an infected person dies
+    Encounter,       ///< Picking who an infectious person meets
+    Transmission,    ///< Whether an encounter passes the disease on
+};
+
+/**
+ * @class Random
+ * @brief Source of random draws keyed by (seed, day, cell, purpose, index)
+ * */
+class Random {
+   private:
+    RandomMode mode = RandomMode::Sequential;  ///< How draws are produced
+    unsigned int seed = 0;                     ///< Seed of the stream and of every key
+    uint64_t epoch = 0;                        ///< Restarts since seeding, so keyed reruns differ
+    std::mt19937 engine;                       ///< Stream for the Sequential mode
+
+   public:
+    explicit Random(unsigned int seed = 0, RandomMode mode = RandomMode::Sequential);
+
+    void reseed(unsigned int seed);
+    void restart();
+
+    double chance(int day, int cell, Purpose purpose, uint32_t index);
+    int pick(int count, int day, int cell, Purpose purpose, uint32_t index);
+
+    RandomMode get_mode() const;
+    unsigned int get_seed() const;
+    uint64_t get_epoch() const;
+
+    void set_mode(RandomMode mode);
+
+   private:
+    uint64_t hash(int day, int cell, Purpose purpose, uint32_t index) const;
+};
+
+#endif
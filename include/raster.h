@@ -0,0 +1,9 @@
+#ifndef RASTER_H
+#define RASTER_H
+
+#include <string>
+#include <vector>
+
+std::vector<int> read_pgm(const std::string &path, int &height, int &width);
+
+#endif
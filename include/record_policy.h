@@ -0,0 +1,51 @@
+#ifndef RECORD_POLICY_H
+#define RECORD_POLICY_H
+
+#include <vector>
+
+/**
+ * @class RecordPolicy
+ * @brief Decides which days a Model records as spatial frames and which window it keeps
+ * */
+class RecordPolicy {
+   private:
+    bool frames = true;     ///< Whether spatial frames are recorded at all
+    int stride = 1;         ///< Record a frame every stride-th day (day 0 included)
+    bool by_days = false;   ///< Whether only the explicit days are recorded, even if none
+    std::vector<int> days;  ///< Explicit days to record (sorted), overrides stride if by_days
+    int row = 0;            ///< Top row of the region of interest
+    int col = 0;            ///< Left column of the region of interest
+    int height = -1;        ///< Height of the region of interest (-1 means whole grid)
+    int width = -1;         ///< Width of the region of interest (-1 means whole grid)
+    bool metrics = false;   ///< Whether spatial metrics are computed each day
+
+   public:
+    RecordPolicy() = default;
+
+    static RecordPolicy full();
+    static RecordPolicy stats_only();
+    static RecordPolicy every(int stride);
+    static RecordPolicy on_days(const std::vector<int> &days);
+
+    bool records(int day) const;
+    int count_frames(int days_in_simulation) const;
+    bool has_region() const;
+
+    bool get_frames() const;
+    int get_stride() const;
+    const std::vector<int> &get_days() const;
+    int get_row() const;
+    int get_col() const;
+    int get_height() const;
+    int get_width() const;
+    bool get_metrics() const;
+
+    void set_region(int row, int col, int height, int width);
+    void clear_region();
+    void set_metrics(bool metrics);
+
+   private:
+    void validate() const;
+};
+
+#endif
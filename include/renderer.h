@@ -0,0 +1,48 @@
+#ifndef RENDERER_H
+#define RENDERER_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class Renderer
+ * @brief Maps status grids through a color palette into RGB frames
+ * */
+class Renderer {
+   public:
+    using Color = std::array<uint8_t, 3>;
+
+   private:
+    std::vector<Color> palette;  ///< RGB color for each Status (Susceptible to Dead)
+    int scale = 1;               ///< Block size for majority downsampling
+    int threads = 0;             ///< Number of worker threads (0 means hardware concurrency)
+
+   public:
+    Renderer(int scale = 1, int threads = 0);
+    Renderer(const std::vector<Color> &palette, int scale = 1, int threads = 0);
+
+    void render(const int *data, int frames, int height, int width, uint8_t *out) const;
+    void render(const uint8_t *data, int frames, int height, int width, uint8_t *out) const;
+    std::vector<uint8_t> render(const std::vector<std::vector<std::vector<int>>> &data) const;
+
+    int get_output_height(int height) const;
+    int get_output_width(int width) const;
+    const std::vector<Color> &get_palette() const;
+    int get_scale() const;
+    int get_threads() const;
+
+    void set_palette(const std::vector<Color> &palette);
+    void set_scale(int scale);
+    void set_threads(int threads);
+
+   private:
+    void validate() const;
+
+    template <typename T>
+    void render_frames(const T *data, int frames, int height, int width, uint8_t *out) const;
+    template <typename T>
+    void render_frame(const T *frame, int height, int width, uint8_t *out) const;
+};
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef SCENARIO_H
+#define SCENARIO_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "class_table.h"
+#include "disease.h"
+#include "layout.h"
+#include "model.h"
+#include "random.h"
+#include "record_policy.h"
+
+/**
+ * @class Scenario
+ * @brief A simulation setup read from a scenario file, runnable without Python
+ * */
+class Scenario {
+   private:
+    std::string name = "";  ///< Name of the scenario (also used for the model)
+
+    double transmission_rate = 0.4;  ///< Disease transmission rate
+    double fatality_rate = 0.02;     ///< Disease fatality rate
+    int days_in_incubation = 12;     ///< Disease days in incubation
+    int days_with_symptoms = 14;     ///< Disease days with symptoms
+
+    int size = 100;                                   ///< Population grid size
+    int travel_radius = 1;                            ///< Population travel radius
+    int encounters = 1;                               ///< Population encounters per person
+    int init_incubations = 1;                         ///< Population initial incubations
+    int init_infections = 0;                          ///< Population initial infections
+    unsigned int seed = 0;                            ///< Population RNG seed
+    std::string zones_path = "";                      ///< PGM raster of zone labels, empty if none
+    Layout layout = Layout::RowMajor;                 ///< Order of Persons in memory
+    int tile = 16;                                    ///< Tile size for the Tiled layout
+    RandomMode random_mode = RandomMode::Sequential;  ///< How random draws are produced
+    bool batched = false;                             ///< Resolve encounters grouped by target
+
+    int days = 100;         ///< Days in simulation
+    RecordPolicy policy;    ///< Which frames the model records and whether it computes metrics
+    size_t memory_cap = 0;  ///< Bytes allowed for population and model, 0 for no cap
+    int pipeline = 0;       ///< Frames stored on a background thread at once, 0 to store inline
+
+    std::vector<int> incubations;   ///< Cells incubated before the first day
+    std::vector<int> vaccinations;  ///< Cells vaccinated before the first day
+
+    std::string classes_path = "";                  ///< PGM raster of cell classes, empty if none
+    std::vector<ClassParameters> class_parameters;  ///< Parameters of each class
+
+    std::vector<Disease> strains;                      ///< Parameters of strains after the first
+    double cross_immunity = 1.0;                       ///< Protection between different strains
+    std::vector<std::vector<int>> strain_incubations;  ///< Cells incubated with each extra strain
+
+    std::string stats_path = "";    ///< CSV output for stats, empty to skip
+    std::string frames_path = "";   ///< Binary output for frames, empty to skip
+    std::string zones_output = "";  ///< CSV output for per-zone stats, empty to skip
+    bool stream = false;            ///< Write frames while simulating instead of holding them
+
+   public:
+    Scenario() = default;
+
+    static Scenario load(const std::string &path);
+
+    std::unique_ptr<Model> build() const;
+    void run() const;
+
+    std::string get_name() const;
+    std::string get_stats_path() const;
+    std::string get_frames_path() const;
+
+   private:
+    void set(const std::string &section, const std::string &key, const std::string &value);
+};
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef SCHEDULE_H
+#define SCHEDULE_H
+
+#include <vector>
+
+#include "person.h"
+#include "population.h"
+
+/**
+ * @brief Enum class representing a simulation parameter a Schedule can change
+ * */
+enum class Parameter {
+    Encounters = 0,    ///< Population encounters per person
+    TravelRadius,      ///< Population travel radius
+    TransmissionRate,  ///< Disease transmission rate
+    FatalityRate,      ///< Disease fatality rate
+};
+
+/**
+ * @class Schedule
+ * @brief Day-indexed and threshold-triggered parameter changes applied inside Model::simulate
+ *
+ * A schedule holds no run state, so one schedule can drive several models. Which once-rules have
+ * fired is kept by the caller, one flag per rule, and passed to apply().
+ * */
+class Schedule {
+   private:
+    /**
+     * @brief Sets a parameter at the start of a given day
+     * */
+    struct Change {
+        int day;              ///< Day on which the change takes effect
+        Parameter parameter;  ///< Parameter to change
+        double value;         ///< New value of the parameter
+    };
+
+    /**
+     * @brief Sets a parameter once a status count crosses a threshold
+     * */
+    struct Rule {
+        Status status;        ///< Status whose count is watched
+        int threshold;        ///< Count that triggers the rule
+        bool above;           ///< Trigger when count >= threshold (true) or <= threshold (false)
+        Parameter parameter;  ///< Parameter to change
+        double value;         ///< New value of the parameter
+        bool once;            ///< Fire only the first time the condition holds
+    };
+
+    std::vector<Change> changes;  ///< Changes sorted by day
+    std::vector<Rule> rules;      ///< Rules in the order they were added
+
+   public:
+    Schedule() = default;
+
+    void add_change(int day, Parameter parameter, double value);
+    void add_rule(Status status, int threshold, Parameter parameter, double value,
+                  bool above = true, bool once = true);
+    void apply(int day, Population &population, std::vector<bool> &fired) const;
+    void clear();
+
+    int get_change_count() const;
+    int get_rule_count() const;
+
+   private:
+    static void validate(Parameter parameter, double value);
+    static void set(Population &population, Parameter parameter, double value);
+};
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef TOPOLOGY_H
+#define TOPOLOGY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "class_table.h"
+#include "layout.h"
+#include "memory.h"
+
+/**
+ * @class Topology
+ * @brief Static structure of a grid: cell order, neighbor table, classes and zones
+ *
+ * A Topology never changes after construction, so one instance can be shared by any number of
+ * Populations, on any number of threads. The with_* methods build a changed copy instead, which
+ * shares the neighbor table whenever it is still valid.
+ * */
+class Topology {
+   private:
+    /**
+     * @brief Neighbor slots of every slot in compressed rows, each row in row-major order
+     * */
+    struct NeighborTable {
+        std::vector<size_t> offsets;  ///< Start of each slot's row, one extra entry at the end
+        std::vector<uint32_t> slots;  ///< Neighbor slots of all rows, back to back
+    };
+
+    int size = 1;                                     ///< Grid size (size x size)
+    int travel_radius = 1;                            ///< Maximum encounter distance
+    Layout layout = Layout::RowMajor;                 ///< Order of cells in memory
+    int tile = 16;                                    ///< Tile size for the Tiled layout
+    std::vector<int> order;                           ///< Row-major cell of each storage slot
+    std::vector<int> slots;                           ///< Storage slot of each row-major cell
+    std::shared_ptr<const NeighborTable> neighbors;   ///< Precomputed neighbors, null if sampled
+    std::vector<uint8_t> classes;                     ///< Class of each cell, empty if none
+    std::shared_ptr<ClassTable> class_table;          ///< Parameters of each class
+    std::vector<int> zones;                           ///< Zone label of each cell, empty if none
+    int zone_count = 0;                               ///< Number of zones (largest label + 1)
+
+   public:
+    Topology(int size, int travel_radius, Layout layout = Layout::RowMajor, int tile = 16,
+             bool neighbor_cache = true);
+
+    std::shared_ptr<const Topology> with_travel_radius(int radius) const;
+    std::shared_ptr<const Topology> with_layout(Layout layout, int tile = 16) const;
+    std::shared_ptr<const Topology> with_neighbor_cache(bool enabled) const;
+    std::shared_ptr<const Topology> with_classes(const std::vector<uint8_t> &classes,
+                                                 std::shared_ptr<ClassTable> table) const;
+    std::shared_ptr<const Topology> without_classes() const;
+    std::shared_ptr<const Topology> with_zones(const std::vector<int> &zones) const;
+    std::shared_ptr<const Topology> without_zones() const;
+
+    int get_size() const;
+    int get_travel_radius() const;
+    Layout get_layout() const;
+    int get_tile() const;
+    bool get_neighbor_cache() const;
+    const std::vector<int> &get_order() const;
+    const std::vector<int> &get_slots() const;
+    int get_neighbor_count(int slot) const;
+    const uint32_t *get_neighbors(int slot) const;
+    const std::vector<uint8_t> &get_classes() const;
+    std::shared_ptr<ClassTable> get_class_table() const;
+    const ClassParameters *get_class_parameters(int cell) const;
+    const std::vector<int> &get_zones() const;
+    int get_zone_count() const;
+    MemoryUsage get_memory() const;
+
+    static MemoryUsage estimate_memory(int size, int travel_radius, bool neighbor_cache = true);
+
+   private:
+    void validate() const;
+    void compute_order();
+    void compute_neighbors();
+};
+
+#endif
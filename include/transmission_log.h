@@ -0,0 +1,38 @@
+#ifndef TRANSMISSION_LOG_H
+#define TRANSMISSION_LOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @class TransmissionLog
+ * @brief Columnar record of (infector cell, infectee cell, day) for every successful infection
+ *
+ * Events are stored as three packed uint32 columns in fixed-size chunks. Chunks are never moved
+ * once allocated, so views into them stay valid while the log grows, until it is cleared.
+ * */
+class TransmissionLog {
+   public:
+    static constexpr size_t CHUNK_SIZE = size_t(1) << 16;  ///< Events per chunk
+
+   private:
+    std::vector<std::unique_ptr<uint32_t[]>> chunks;  ///< Each chunk holds the three columns
+    size_t size = 0;                                  ///< Number of recorded events
+
+   public:
+    TransmissionLog() = default;
+
+    void record(uint32_t infector, uint32_t infectee, uint32_t day);
+    void clear();
+
+    size_t get_size() const;
+    int get_chunk_count() const;
+    size_t get_chunk_size(int chunk) const;
+    const uint32_t *get_infectors(int chunk) const;
+    const uint32_t *get_infectees(int chunk) const;
+    const uint32_t *get_days(int chunk) const;
+};
+
+#endif
@@ -0,0 +1,13 @@
+#ifndef WRITER_H
+#define WRITER_H
+
+#include <string>
+
+#include "frame_stream.h"
+#include "model.h"
+
+void write_stats_csv(const Model &model, const std::string &path);
+void write_zone_stats_csv(const Model &model, const std::string &path);
+void write_frames(const Model &model, const std::string &path);
+
+#endif
@@ -0,0 +1,243 @@
+#include "calibrator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "disease.h"
+#include "person.h"
+#include "population.h"
+#include "topology.h"
+
+Calibrator::Calibrator(const std::vector<int> &observed, double tolerance, int size,
+                       int travel_radius, int encounters, int init_incubations,
+                       int init_infections, Status status, unsigned int seed, int threads)
+    : observed(observed),
+      tolerance(tolerance),
+      status(status),
+      size(size),
+      travel_radius(travel_radius),
+      encounters(encounters),
+      init_incubations(init_incubations),
+      init_infections(init_infections),
+      threads(threads) {
+    if (observed.empty()) {
+        throw std::invalid_argument("Observed series cannot be empty");
+    }
+    validate();
+
+    // Initalize the seed the same way Population does
+    std::random_device rd;
+    this->seed = (seed == 0) ? rd() : seed;
+}
+
+std::vector<CalibrationSample> Calibrator::run(int candidates) {
+    if (candidates < 0) {
+        throw std::invalid_argument("Candidates must be non-negative");
+    }
+
+    std::vector<CalibrationSample> samples(candidates);
+    std::vector<char> accepted(candidates, 0);
+    std::vector<int> days(candidates, 0);
+
+    // Candidates are independent, so workers simply pull the next unevaluated one
+    int workers = (threads == 0) ? static_cast<int>(std::thread::hardware_concurrency()) : threads;
+    workers = std::max(1, std::min(workers, candidates));
+
+    // NOTE: Candidates only differ in their disease, so they all share one neighbor table
+    auto topology = std::make_shared<const Topology>(size, travel_radius);
+
+    // NOTE: An exception escaping a worker would terminate the process, so the first one is kept,
+    // no further candidates are handed out and it is rethrown here once every worker has joined
+    std::atomic<int> next(0);
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto work = [&]() {
+        for (int c = next++; c < candidates; c = next++) {
+            try {
+                accepted[c] = evaluate(c, topology, samples[c], days[c]) ? 1 : 0;
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) error = std::current_exception();
+                next = candidates;
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (int t = 1; t < workers; ++t) {
+        pool.emplace_back(work);
+    }
+    work();
+    for (auto &thread : pool) {
+        thread.join();
+    }
+    if (error) std::rethrow_exception(error);
+
+    // Keep accepted samples in candidate order so results do not depend on thread timing
+    std::vector<CalibrationSample> result;
+    rejected = 0;
+    simulated_days = 0;
+    for (int c = 0; c < candidates; ++c) {
+        simulated_days += days[c];
+        if (accepted[c]) {
+            result.push_back(samples[c]);
+        } else {
+            rejected += 1;
+        }
+    }
+    return result;
+}
+
+Prior Calibrator::get_transmission_rate_prior() const {
+    return transmission_rate;
+}
+
+Prior Calibrator::get_fatality_rate_prior() const {
+    return fatality_rate;
+}
+
+Prior Calibrator::get_days_in_incubation_prior() const {
+    return days_in_incubation;
+}
+
+Prior Calibrator::get_days_with_symptoms_prior() const {
+    return days_with_symptoms;
+}
+
+double Calibrator::get_tolerance() const {
+    return tolerance;
+}
+
+unsigned int Calibrator::get_seed() const {
+    return seed;
+}
+
+int Calibrator::get_threads() const {
+    return threads;
+}
+
+int Calibrator::get_rejected() const {
+    return rejected;
+}
+
+long long Calibrator::get_simulated_days() const {
+    return simulated_days;
+}
+
+void Calibrator::set_transmission_rate_prior(double low, double high) {
+    transmission_rate = {low, high};
+    validate();
+}
+
+void Calibrator::set_fatality_rate_prior(double low, double high) {
+    fatality_rate = {low, high};
+    validate();
+}
+
+void Calibrator::set_days_in_incubation_prior(double low, double high) {
+    days_in_incubation = {low, high};
+    validate();
+}
+
+void Calibrator::set_days_with_symptoms_prior(double low, double high) {
+    days_with_symptoms = {low, high};
+    validate();
+}
+
+void Calibrator::set_tolerance(double tolerance) {
+    this->tolerance = tolerance;
+    validate();
+}
+
+void Calibrator::set_seed(unsigned int seed) {
+    this->seed = seed;
+}
+
+void Calibrator::set_threads(int threads) {
+    this->threads = threads;
+    validate();
+}
+
+void Calibrator::validate() const {
+    if (tolerance < 0) {
+        throw std::invalid_argument("Tolerance must be non-negative");
+    }
+    if (threads < 0) {
+        throw std::invalid_argument("Threads must be non-negative");
+    }
+    if (transmission_rate.low > transmission_rate.high ||
+        fatality_rate.low > fatality_rate.high ||
+        days_in_incubation.low > days_in_incubation.high ||
+        days_with_symptoms.low > days_with_symptoms.high) {
+        throw std::invalid_argument("Prior lower bound must not exceed upper bound");
+    }
+    if (transmission_rate.low < 0 || transmission_rate.high > 1 || fatality_rate.low < 0 ||
+        fatality_rate.high > 1) {
+        throw std::invalid_argument("Rate priors must be between 0 and 1");
+    }
+    if (days_in_incubation.low < 0 || days_with_symptoms.low < 0) {
+        throw std::invalid_argument("Day priors must be non-negative");
+    }
+    // NOTE: Candidates are built on worker threads, so catch what Population would reject here
+    if (size <= 0 || travel_radius < 0 || encounters < 0 || init_incubations < 0 ||
+        init_infections < 0) {
+        throw std::invalid_argument("Population parameters must be non-negative");
+    }
+    if (init_incubations < init_infections ||
+        init_incubations + init_infections > size * size) {
+        throw std::invalid_argument("Initial incubations and infections do not fit the population");
+    }
+}
+
+bool Calibrator::evaluate(int candidate, const std::shared_ptr<const Topology> &topology,
+                          CalibrationSample &sample, int &days) const {
+    // Each candidate gets its own stream so results do not depend on thread count
+    std::seed_seq sequence{seed, static_cast<unsigned int>(candidate)};
+    std::mt19937 rng(sequence);
+
+    std::uniform_real_distribution<double> transmission(transmission_rate.low,
+                                                        transmission_rate.high);
+    std::uniform_real_distribution<double> fatality(fatality_rate.low, fatality_rate.high);
+    std::uniform_int_distribution<int> incubation(
+        static_cast<int>(std::lround(days_in_incubation.low)),
+        static_cast<int>(std::lround(days_in_incubation.high)));
+    std::uniform_int_distribution<int> symptoms(
+        static_cast<int>(std::lround(days_with_symptoms.low)),
+        static_cast<int>(std::lround(days_with_symptoms.high)));
+
+    sample.transmission_rate = transmission(rng);
+    sample.fatality_rate = fatality(rng);
+    sample.days_in_incubation = incubation(rng);
+    sample.days_with_symptoms = symptoms(rng);
+
+    // NOTE: Population treats seed 0 as "pick one", so never hand it a zero
+    unsigned int population_seed = std::max(1u, static_cast<unsigned int>(rng()));
+    auto disease = std::make_shared<Disease>(sample.transmission_rate, sample.fatality_rate,
+                                             sample.days_in_incubation,
+                                             sample.days_with_symptoms);
+    Population population(topology, encounters, init_incubations, init_infections, disease,
+                          population_seed);
+
+    // The distance only grows, so a partial trajectory past the tolerance can never come back
+    const int index = static_cast<int>(status);
+    double distance = std::abs(population.get_status_count()[index] - observed[0]);
+    days = 0;
+    for (size_t d = 1; d < observed.size() && distance <= tolerance; ++d) {
+        population.update();
+        distance += std::abs(population.get_status_count()[index] - observed[d]);
+        days += 1;
+    }
+
+    sample.distance = distance;
+    return distance <= tolerance;
+}
@@ -0,0 +1,37 @@
+#include "class_table.h"
+
+#include <stdexcept>
+#include <vector>
+
+ClassTable::ClassTable(const std::vector<ClassParameters> &classes) : classes(classes) {
+    validate();
+}
+
+const ClassParameters &ClassTable::get(int index) const {
+    return classes[index];
+}
+
+const std::vector<ClassParameters> &ClassTable::get_classes() const {
+    return classes;
+}
+
+int ClassTable::get_size() const {
+    return static_cast<int>(classes.size());
+}
+
+void ClassTable::validate() const {
+    if (classes.empty() || classes.size() > 256) {
+        throw std::invalid_argument("Class table must have between 1 and 256 classes");
+    }
+    for (const ClassParameters &parameters : classes) {
+        if (parameters.susceptibility < 0) {
+            throw std::invalid_argument("Susceptibility must be non-negative");
+        }
+        if (parameters.fatality_rate < 0 || parameters.fatality_rate > 1) {
+            throw std::invalid_argument("Fatality rate must be between 0 and 1");
+        }
+        if (parameters.days_in_incubation < 0 || parameters.days_with_symptoms < 0) {
+            throw std::invalid_argument("Days in incubation and with symptoms must be non-negative");
+        }
+    }
+}
@@ -0,0 +1,100 @@
+#include "frame_pipeline.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+FramePipeline::FramePipeline(size_t frame_size, int depth, Sink sink)
+    : frame_size(frame_size), sink(std::move(sink)) {
+    if (depth <= 0) {
+        throw std::invalid_argument("Pipeline depth must be positive");
+    }
+    if (!this->sink) {
+        throw std::invalid_argument("Frame sink cannot be empty");
+    }
+    buffers.assign(depth, std::vector<uint8_t>(frame_size));
+    days.assign(depth, 0);
+    worker = std::thread(&FramePipeline::run, this);
+}
+
+FramePipeline::~FramePipeline() {
+    // NOTE: Frames already submitted are still stored, failures are dropped as nobody can see them
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    submitted_frame.notify_one();
+    worker.join();
+}
+
+uint8_t *FramePipeline::acquire() {
+    std::unique_lock<std::mutex> lock(mutex);
+    // NOTE: Backpressure, the simulation waits here while every buffer is still in flight
+    stored_frame.wait(lock, [this] { return submitted - stored < buffers.size() || error; });
+    rethrow();
+    return buffers[submitted % buffers.size()].data();
+}
+
+void FramePipeline::submit(int day) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        rethrow();
+        days[submitted % buffers.size()] = day;
+        submitted += 1;
+    }
+    submitted_frame.notify_one();
+}
+
+void FramePipeline::flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    stored_frame.wait(lock, [this] { return stored == submitted; });
+    rethrow();
+}
+
+int FramePipeline::get_depth() const {
+    return static_cast<int>(buffers.size());
+}
+
+size_t FramePipeline::get_frame_size() const {
+    return frame_size;
+}
+
+void FramePipeline::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        submitted_frame.wait(lock, [this] { return stored < submitted || stopping; });
+        if (stored == submitted) return;
+
+        // Store the oldest frame without holding the lock, the simulation may fill other buffers
+        // NOTE: After a failure frames are only dropped, so the simulation never waits on a
+        // broken sink before it sees the error
+        size_t slot = stored % buffers.size();
+        int day = days[slot];
+        bool failed = error != nullptr;
+        lock.unlock();
+        std::exception_ptr caught;
+        if (!failed) {
+            try {
+                sink(day, buffers[slot].data());
+            } catch (...) {
+                caught = std::current_exception();
+            }
+        }
+        lock.lock();
+
+        if (caught) error = caught;
+        stored += 1;
+        stored_frame.notify_one();
+    }
+}
+
+void FramePipeline::rethrow() {
+    // NOTE: Called with the lock held. The error is kept, so once a frame is lost every later call
+    // fails too and nothing is stored after the gap.
+    if (error) std::rethrow_exception(error);
+}
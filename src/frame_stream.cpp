@@ -0,0 +1,88 @@
+#include "frame_stream.h"
+
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+FrameStream::FrameStream(const std::string &path, int height, int width, int capacity)
+    : path(path), height(height), width(width), capacity(capacity) {
+    if (height < 0 || width < 0 || capacity < 0) {
+        throw std::invalid_argument("Frame height, width and capacity must be non-negative");
+    }
+    days.reserve(capacity);
+    open();
+}
+
+void FrameStream::write(int day, const uint8_t *frame) {
+    if (static_cast<int>(days.size()) >= capacity) {
+        throw std::runtime_error("Frames file is full: " + path);
+    }
+    file.write(reinterpret_cast<const char *>(frame),
+               static_cast<std::streamsize>(height) * width);
+    days.push_back(static_cast<int32_t>(day));
+    if (!file) {
+        throw std::runtime_error("Failed writing frames file: " + path);
+    }
+}
+
+void FrameStream::flush() {
+    uint32_t header[5] = {FRAMES_VERSION, static_cast<uint32_t>(days.size()),
+                          static_cast<uint32_t>(height), static_cast<uint32_t>(width),
+                          static_cast<uint32_t>(capacity)};
+    file.seekp(sizeof(FRAMES_MAGIC));
+    file.write(reinterpret_cast<const char *>(header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(days.data()),
+               static_cast<std::streamsize>(days.size() * sizeof(int32_t)));
+    file.seekp(get_frames_end());
+    file.flush();
+
+    if (!file) {
+        throw std::runtime_error("Failed writing frames file: " + path);
+    }
+}
+
+void FrameStream::clear() {
+    file.close();
+    days.clear();
+    open();
+}
+
+const std::string &FrameStream::get_path() const {
+    return path;
+}
+
+int FrameStream::get_frame_count() const {
+    return static_cast<int>(days.size());
+}
+
+int FrameStream::get_height() const {
+    return height;
+}
+
+int FrameStream::get_width() const {
+    return width;
+}
+
+int FrameStream::get_capacity() const {
+    return capacity;
+}
+
+void FrameStream::open() {
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw std::runtime_error("Cannot open frames file: " + path);
+    }
+    // Reserve the header and a zeroed day table, frames start right after it
+    std::vector<char> table(5 * sizeof(uint32_t) + capacity * sizeof(int32_t), 0);
+    file.write(FRAMES_MAGIC, sizeof(FRAMES_MAGIC));
+    file.write(table.data(), static_cast<std::streamsize>(table.size()));
+    flush();
+}
+
+std::streamoff FrameStream::get_frames_end() const {
+    return static_cast<std::streamoff>(sizeof(FRAMES_MAGIC) + 5 * sizeof(uint32_t) +
+                                       capacity * sizeof(int32_t)) +
+           static_cast<std::streamoff>(days.size()) * height * width;
+}
@@ -0,0 +1,54 @@
+#include "layout.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+// Spread the low 32 bits of x so a zero bit sits between each of them
+static uint64_t spread_bits(uint64_t x) {
+    x &= 0xffffffffULL;
+    x = (x | (x << 16)) & 0x0000ffff0000ffffULL;
+    x = (x | (x << 8)) & 0x00ff00ff00ff00ffULL;
+    x = (x | (x << 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    x = (x | (x << 2)) & 0x3333333333333333ULL;
+    x = (x | (x << 1)) & 0x5555555555555555ULL;
+    return x;
+}
+
+std::vector<int> order_cells(int size, Layout layout, int tile) {
+    if (size <= 0) {
+        throw std::invalid_argument("Size must be positive");
+    }
+    if (tile <= 0) {
+        throw std::invalid_argument("Tile size must be positive");
+    }
+
+    // Position k holds the row-major index of the k-th cell in memory
+    std::vector<int> order(static_cast<size_t>(size) * size);
+    std::iota(order.begin(), order.end(), 0);
+
+    if (layout == Layout::Morton) {
+        // NOTE: Sizes that are not a power of two leave gaps in the curve, sorting skips them
+        std::vector<uint64_t> codes(order.size());
+        for (int i = 0; i < size; ++i) {
+            for (int j = 0; j < size; ++j) {
+                codes[i * size + j] = (spread_bits(i) << 1) | spread_bits(j);
+            }
+        }
+        std::sort(order.begin(), order.end(), [&](int a, int b) { return codes[a] < codes[b]; });
+    } else if (layout == Layout::Tiled) {
+        size_t k = 0;
+        for (int ti = 0; ti < size; ti += tile) {
+            for (int tj = 0; tj < size; tj += tile) {
+                for (int i = ti; i < std::min(ti + tile, size); ++i) {
+                    for (int j = tj; j < std::min(tj + tile, size); ++j) {
+                        order[k++] = i * size + j;
+                    }
+                }
+            }
+        }
+    }
+    return order;
+}
@@ -0,0 +1,29 @@
+#include "memory.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+
+size_t MemoryUsage::total() const {
+    return people + neighbors + infectious + tables + log + history;
+}
+
+std::string MemoryUsage::describe() const {
+    return format_bytes(total()) + " (people " + format_bytes(people) + ", neighbors " +
+           format_bytes(neighbors) + ", infectious " + format_bytes(infectious) + ", tables " +
+           format_bytes(tables) + ", log " + format_bytes(log) + ", history " +
+           format_bytes(history) + ")";
+}
+
+std::string format_bytes(size_t bytes) {
+    const char *units[] = {"B", "KiB", "MiB", "GiB", "TiB"};
+    double value = static_cast<double>(bytes);
+    int unit = 0;
+    while (value >= 1024.0 && unit < 4) {
+        value /= 1024.0;
+        unit += 1;
+    }
+    char text[32];
+    std::snprintf(text, sizeof(text), unit == 0 ? "%.0f %s" : "%.1f %s", value, units[unit]);
+    return text;
+}
@@ -0,0 +1,102 @@
+#include "metrics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "person.h"
+#include "population.h"
+
+SpatialMetrics::SpatialMetrics(const Population &population)
+    : size(population.get_size()),
+      parent(static_cast<size_t>(population.get_size()) * population.get_size(), -1),
+      last_seen(parent.size(), -2) {}
+
+std::vector<double> SpatialMetrics::measure(const Population &population) {
+    const std::vector<Person *> &new_infections = population.get_new_infections();
+    const std::vector<Person *> &infectious = population.get_infectious_people();
+
+    // Seeds: carriers neither infected by an encounter now nor carriers at the last measure
+    // NOTE: Catches the initial cases as well as ones seeded later, of any strain
+    for (const Person *person : new_infections) {
+        std::pair<int, int> pos = person->get_position();
+        last_seen[pos.first * size + pos.second] = tick;
+    }
+    for (const Person *person : infectious) {
+        std::pair<int, int> pos = person->get_position();
+        int &seen = last_seen[pos.first * size + pos.second];
+        if (seen != tick && seen != tick - 1) seeds.push_back(pos);
+        seen = tick;
+    }
+    tick += 1;
+
+    // Front: farthest any infection has landed from its nearest seed
+    // NOTE: Cost is new infections x seeds, seeds are only the handful of seeded cases
+    for (const Person *person : new_infections) {
+        std::pair<int, int> pos = person->get_position();
+        double nearest = std::numeric_limits<double>::infinity();
+        for (const auto &seed : seeds) {
+            double di = pos.first - seed.first;
+            double dj = pos.second - seed.second;
+            nearest = std::min(nearest, std::sqrt(di * di + dj * dj));
+        }
+        if (nearest != std::numeric_limits<double>::infinity()) {
+            front = std::max(front, nearest);
+        }
+    }
+
+    int infectors = population.get_infectors();
+    double infections = static_cast<double>(new_infections.size());
+    return {front, static_cast<double>(count_clusters(infectious)),
+            infections, (infectors > 0) ? infections / infectors : 0.0};
+}
+
+int SpatialMetrics::count_clusters(const std::vector<Person *> &infectious) {
+    // NOTE: Union-find cannot undo unions when people recover, so the forest is rebuilt over the
+    // infectious cells each day and cleared again afterwards, never touching the rest of the grid
+    for (const Person *person : infectious) {
+        std::pair<int, int> pos = person->get_position();
+        int cell = pos.first * size + pos.second;
+        parent[cell] = cell;
+    }
+
+    int clusters = static_cast<int>(infectious.size());
+    for (const Person *person : infectious) {
+        std::pair<int, int> pos = person->get_position();
+        int cell = pos.first * size + pos.second;
+
+        // Half of the 8-neighborhood is enough to see every adjacent pair once
+        const int offsets[4][2] = {{-1, -1}, {-1, 0}, {-1, 1}, {0, -1}};
+        for (const auto &offset : offsets) {
+            int ni = pos.first + offset[0];
+            int nj = pos.second + offset[1];
+            if (ni < 0 || ni >= size || nj < 0 || nj >= size) continue;
+            int other = ni * size + nj;
+            if (parent[other] < 0) continue;
+
+            int a = find(cell);
+            int b = find(other);
+            if (a != b) {
+                parent[std::max(a, b)] = std::min(a, b);
+                clusters -= 1;
+            }
+        }
+    }
+
+    for (const Person *person : infectious) {
+        std::pair<int, int> pos = person->get_position();
+        parent[pos.first * size + pos.second] = -1;
+    }
+    return clusters;
+}
+
+int SpatialMetrics::find(int cell) {
+    // Path halving
+    while (parent[cell] != cell) {
+        parent[cell] = parent[parent[cell]];
+        cell = parent[cell];
+    }
+    return cell;
+}
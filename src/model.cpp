@@ -1,35 +1,77 @@
 #include "model.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "frame_pipeline.h"
+#include "frame_stream.h"
+#include "memory.h"
+#include "metrics.h"
 #include "population.h"
+#include "random.h"
+#include "record_policy.h"
+#include "schedule.h"
 
 Model::Model(int days_in_simulation, std::shared_ptr<Population> population,
-             const std::string &name)
+             const std::string &name, const RecordPolicy &policy, size_t memory_cap,
+             const std::string &frames_path)
     : remain_days(days_in_simulation),
       current_day(1),
       days_in_simulation(days_in_simulation),
       population(std::move(population)),
-      name(name) {
+      name(name),
+      policy(policy) {
     if (this->population.get() == nullptr) {
         throw std::invalid_argument("Population shared pointer cannot be null");
     }
     if (days_in_simulation < 0) {
         throw std::invalid_argument("Days in simulation must be non-negative");
     }
-    // Reserve all the necessary memory
-    data.reserve(days_in_simulation + 1);
+    if (policy.has_region()) {
+        int size = this->population->get_size();
+        if (policy.get_row() + policy.get_height() > size ||
+            policy.get_col() + policy.get_width() > size) {
+            throw std::invalid_argument("Recording region must lie within the population grid");
+        }
+    }
+    // NOTE: May switch to cheaper representations, so use this->policy from here on
+    if (memory_cap > 0) fit_memory(memory_cap, !frames_path.empty());
+
+    // Reserve only the memory the policy is going to use
+    int frame_count = this->policy.count_frames(days_in_simulation);
+    int size = this->population->get_size();
+    frame_height = this->policy.has_region() ? this->policy.get_height() : size;
+    frame_width = this->policy.has_region() ? this->policy.get_width() : size;
+    if (!frames_path.empty()) {
+        // NOTE: Streamed frames go to the file as they are recorded and are never held here
+        stream = std::make_unique<FrameStream>(frames_path, frame_height, frame_width, frame_count);
+    } else {
+        frames.reserve(static_cast<size_t>(frame_count) * frame_height * frame_width);
+        frame_days.reserve(frame_count);
+    }
     stats.reserve(days_in_simulation + 1);
+    zone_count = this->population->get_zone_count();
+    if (zone_count > 0) {
+        zone_stats.reserve(days_in_simulation + 1);
+    }
+    if (this->policy.get_metrics()) {
+        metrics.reserve(days_in_simulation + 1);
+        tracker = std::make_unique<SpatialMetrics>(*this->population);
+    }
 
-    stats.push_back(this->population->get_status_count());
-    data.push_back(this->population->get_people());
+    record(0);
+    flush_frames();
 }
 
-bool Model::simulate(int days = -1) {
+bool Model::simulate(int days = -1, const std::shared_ptr<Schedule> &schedule) {
     if (days < -1) {
         throw std::invalid_argument("Days must be non-negative or -1");
     }
@@ -37,31 +79,69 @@ bool Model::simulate(int days = -1) {
     // Determine the number of days to run the simulation
     days = (days == -1) ? remain_days : std::min(days, remain_days);
     if (days <= 0) return false;
+    // NOTE: Every zone_stats row must have the same width, checked before any day is computed
+    if (population->get_zone_count() != zone_count) {
+        throw std::runtime_error("Population zones changed since the last reset of the model");
+    }
+
+    // NOTE: Remember what schedules are about to change so reset can undo it. The rules fired
+    // are kept here rather than in the schedule, so a schedule shared between models fires in each
+    std::vector<bool> *schedule_fired = nullptr;
+    if (schedule) {
+        if (schedules.empty()) {
+            unscheduled_encounters = population->get_encounters();
+            unscheduled_travel_radius = population->get_travel_radius();
+        }
+        auto it = std::find(schedules.begin(), schedules.end(), schedule);
+        if (it == schedules.end()) {
+            schedules.push_back(schedule);
+            fired.emplace_back();
+            it = schedules.end() - 1;
+        }
+        schedule_fired = &fired[it - schedules.begin()];
+    }
 
     // Print initial progress bar
-    print_progress_bar(0, days);
+    if (verbose) print_progress_bar(0, days);
     const int update_interval = std::max(1, days / 10);
 
     for (int d = 1; d <= days; ++d) {
+        // NOTE: Scheduled changes for a day take effect before that day is computed
+        if (schedule) {
+            schedule->apply(current_day + d - 1, *population, *schedule_fired);
+        }
         population->update();
-        data.push_back(population->get_people());
-        stats.push_back(population->get_status_count());
+        record(current_day + d - 1);
 
         // Update progress bar after each day
-        if (d % update_interval == 0 || d == days) {
+        if (verbose && (d % update_interval == 0 || d == days)) {
             print_progress_bar(d, days);
         }
     }
     remain_days -= days;
     current_day += days;
+    flush_frames();
 
     // Newline after progress bar
-    std::cout << std::endl;
+    if (verbose) std::cout << std::endl;
 
     return true;
 }
 
 void Model::reset(bool same_seed) {
+    // Let the pipeline finish before clearing what it stores into, a failed one is rebuilt below
+    int depth = get_pipeline_depth();
+    pipeline.reset();
+
+    // Undo scheduled changes and re-arm the rules, so a rerun starts from the same parameters
+    if (!schedules.empty()) {
+        population->clear_disease_overrides();
+        population->set_encounters(unscheduled_encounters);
+        population->set_travel_radius(unscheduled_travel_radius);
+        schedules.clear();
+        fired.clear();
+    }
+
     // Reset time
     remain_days = days_in_simulation;
     current_day = 1;
@@ -70,21 +150,74 @@ void Model::reset(bool same_seed) {
     population->reset(same_seed);
 
     // Reset internal data
-    data.clear();
-    data.push_back(population->get_people());
-
+    frames.clear();
+    frame_days.clear();
     stats.clear();
-    stats.push_back(population->get_status_count());
+    metrics.clear();
+    zone_stats.clear();
+    zone_count = population->get_zone_count();
+    if (stream) stream->clear();
+    set_pipeline_depth(depth);
+    if (policy.get_metrics()) {
+        tracker = std::make_unique<SpatialMetrics>(*population);
+    }
+
+    record(0);
+    flush_frames();
 }
 
-const std::vector<std::vector<std::vector<int>>> &Model::get_data() const {
+std::vector<std::vector<std::vector<int>>> Model::get_data() const {
+    // NOTE: Frames are stored one byte per cell, this expands a copy for callers wanting nested grids
+    std::vector<std::vector<std::vector<int>>> data(
+        frame_days.size(),
+        std::vector<std::vector<int>>(frame_height, std::vector<int>(frame_width)));
+    const uint8_t *cell = frames.data();
+    for (auto &frame : data) {
+        for (auto &row : frame) {
+            for (int &value : row) {
+                value = *cell++;
+            }
+        }
+    }
     return data;
 }
 
+const std::vector<uint8_t> &Model::get_frames() const {
+    return frames;
+}
+
+int Model::get_frame_count() const {
+    return static_cast<int>(frame_days.size());
+}
+
+int Model::get_frame_height() const {
+    return frame_height;
+}
+
+int Model::get_frame_width() const {
+    return frame_width;
+}
+
+const std::vector<int> &Model::get_frame_days() const {
+    return frame_days;
+}
+
 const std::vector<std::vector<int>> &Model::get_stats() const {
     return stats;
 }
 
+const std::vector<std::vector<double>> &Model::get_metrics() const {
+    return metrics;
+}
+
+const std::vector<std::vector<int>> &Model::get_zone_stats() const {
+    return zone_stats;
+}
+
+const RecordPolicy &Model::get_policy() const {
+    return policy;
+}
+
 std::shared_ptr<Population> Model::get_population() const {
     return population;
 }
@@ -101,10 +234,223 @@ std::string Model::get_name() const {
     return name;
 }
 
+bool Model::get_verbose() const {
+    return verbose;
+}
+
+int Model::get_pipeline_depth() const {
+    return pipeline ? pipeline->get_depth() : 0;
+}
+
+std::string Model::get_frames_path() const {
+    return stream ? stream->get_path() : "";
+}
+
+MemoryUsage Model::get_memory() const {
+    MemoryUsage usage = population->get_memory();
+    usage.history = frames.capacity() + frame_days.capacity() * sizeof(int) +
+                    stats.capacity() * sizeof(std::vector<int>) +
+                    metrics.capacity() * sizeof(std::vector<double>) +
+                    zone_stats.capacity() * sizeof(std::vector<int>) + frame_buffer.capacity();
+    if (pipeline) usage.history += pipeline->get_depth() * pipeline->get_frame_size();
+    for (const auto &row : stats) usage.history += row.capacity() * sizeof(int);
+    for (const auto &row : metrics) usage.history += row.capacity() * sizeof(double);
+    for (const auto &row : zone_stats) usage.history += row.capacity() * sizeof(int);
+    return usage;
+}
+
 void Model::set_name(const std::string &name) {
     this->name = name;
 }
 
+void Model::set_verbose(bool verbose) {
+    this->verbose = verbose;
+}
+
+void Model::set_pipeline_depth(int depth) {
+    if (depth < 0) {
+        throw std::invalid_argument("Pipeline depth must be non-negative");
+    }
+    if (depth == get_pipeline_depth()) return;
+
+    // Frames already handed over are stored before the buffers go away
+    flush_frames();
+    pipeline.reset();
+    if (depth > 0) {
+        size_t frame_size = static_cast<size_t>(frame_height) * frame_width;
+        pipeline = std::make_unique<FramePipeline>(
+            frame_size, depth, [this](int day, const uint8_t *frame) { store_frame(day, frame); });
+    }
+}
+
+MemoryUsage Model::estimate_memory(int days_in_simulation, const Population &population,
+                                   const RecordPolicy &policy) {
+    if (days_in_simulation < 0) {
+        throw std::invalid_argument("Days in simulation must be non-negative");
+    }
+    size_t rows = static_cast<size_t>(days_in_simulation) + 1;
+    size_t frame_count = policy.count_frames(days_in_simulation);
+    size_t height = policy.has_region() ? policy.get_height() : population.get_size();
+    size_t width = policy.has_region() ? policy.get_width() : population.get_size();
+    int strains = population.get_strain_count();
+    size_t columns = 5 + (strains > 1 ? 3 * strains : 0);
+
+    MemoryUsage usage = population.get_memory();
+    // NOTE: The newly infected list and the encounter buffers only grow once carriers spread, so
+    // count them at peak
+    int batched_encounters = population.get_batched() ? population.get_encounters() : 0;
+    MemoryUsage peak =
+        Population::estimate_memory(population.get_size(), 0, false, batched_encounters);
+    usage.infectious = std::max(usage.infectious, peak.infectious);
+    usage.history = frame_count * (height * width + sizeof(int)) +
+                    rows * (sizeof(std::vector<int>) + columns * sizeof(int));
+    if (policy.get_metrics()) {
+        usage.history += rows * (sizeof(std::vector<double>) + METRIC_COUNT * sizeof(double));
+    }
+    if (population.get_zone_count() > 0) {
+        usage.history +=
+            rows * (sizeof(std::vector<int>) + population.get_zone_count() * 5 * sizeof(int));
+    }
+    return usage;
+}
+
+void Model::fit_memory(size_t memory_cap, bool streaming) {
+    // Try the cheaper representations in turn, but change nothing unless the result fits
+    MemoryUsage usage = estimate_memory(days_in_simulation, *population, policy);
+    bool drop_neighbors = false;
+    RecordPolicy fitted = policy;
+    if (streaming) {
+        // NOTE: Streamed frames are never held, so only count what stats_only would keep
+        RecordPolicy held = RecordPolicy::stats_only();
+        held.set_metrics(policy.get_metrics());
+        usage.history = estimate_memory(days_in_simulation, *population, held).history;
+    }
+    if (usage.total() > memory_cap && usage.neighbors > 0) {
+        // NOTE: Sampling neighbors on the fly picks the same people, only slower
+        drop_neighbors = true;
+        usage.neighbors = 0;
+    }
+    if (usage.total() > memory_cap && policy.count_frames(days_in_simulation) > 0) {
+        fitted = RecordPolicy::stats_only();
+        fitted.set_metrics(policy.get_metrics());
+        usage.history = estimate_memory(days_in_simulation, *population, fitted).history;
+    }
+    if (usage.total() > memory_cap) {
+        throw std::invalid_argument("Model needs at least " + usage.describe() +
+                                    ", over the memory cap of " + format_bytes(memory_cap));
+    }
+
+    if (drop_neighbors) population->set_neighbor_cache(false);
+    policy = fitted;
+}
+
+void Model::record(int day) {
+    // NOTE: Stats are cheap and always recorded, frames only when the policy asks for them
+    // NOTE: Strains must be added before the Model is built to line up with stats
+    std::vector<int> row = population->get_status_count();
+    if (population->get_strain_count() > 1) {
+        const std::vector<int> &counts = population->get_strain_counts();
+        row.insert(row.end(), counts.begin(), counts.end());
+    }
+    stats.push_back(std::move(row));
+    if (tracker) metrics.push_back(tracker->measure(*population));
+    // NOTE: Zones must be assigned before the Model is built to line up with stats
+    if (population->get_zone_count() > 0) zone_stats.push_back(population->get_zone_counts());
+    if (!policy.records(day)) return;
+
+    int top = policy.has_region() ? policy.get_row() : 0;
+    int left = policy.has_region() ? policy.get_col() : 0;
+    if (pipeline) {
+        // NOTE: Only gathering the statuses stays on the critical path, storing them overlaps
+        // with the next day. acquire waits while every buffer is still being stored.
+        population->copy_statuses(pipeline->acquire(), top, left, frame_height, frame_width);
+        pipeline->submit(day);
+    } else if (stream) {
+        frame_buffer.resize(static_cast<size_t>(frame_height) * frame_width);
+        population->copy_statuses(frame_buffer.data(), top, left, frame_height, frame_width);
+        stream->write(day, frame_buffer.data());
+    } else {
+        size_t offset = frames.size();
+        frames.resize(offset + static_cast<size_t>(frame_height) * frame_width);
+        population->copy_statuses(frames.data() + offset, top, left, frame_height, frame_width);
+        frame_days.push_back(day);
+    }
+}
+
+void Model::store_frame(int day, const uint8_t *frame) {
+    // NOTE: Runs on the pipeline worker, which alone touches frames and the stream meanwhile
+    if (stream) {
+        stream->write(day, frame);
+        return;
+    }
+    frames.insert(frames.end(), frame, frame + static_cast<size_t>(frame_height) * frame_width);
+    frame_days.push_back(day);
+}
+
+void Model::flush_frames() {
+    // Wait for the pipeline first so the stream header covers every recorded frame
+    if (pipeline) pipeline->flush();
+    if (stream) stream->flush();
+}
+
+bool simulate_paired(Model &baseline, Model &intervention, int days,
+                     const std::shared_ptr<Schedule> &baseline_schedule,
+                     const std::shared_ptr<Schedule> &intervention_schedule) {
+    const Population &first = *baseline.get_population();
+    const Population &second = *intervention.get_population();
+    if (&first == &second) {
+        throw std::invalid_argument("Paired models need separate populations");
+    }
+    // NOTE: Common random numbers only line up when draws are keyed the same way on the same grid
+    if (first.get_random_mode() != RandomMode::Keyed ||
+        second.get_random_mode() != RandomMode::Keyed) {
+        throw std::invalid_argument("Paired populations must use the keyed random mode");
+    }
+    if (first.get_seed() != second.get_seed() || first.get_size() != second.get_size()) {
+        throw std::invalid_argument("Paired populations must share seed and size");
+    }
+    // NOTE: Draws are keyed by day and restart epoch, so a model advanced or reset on its own
+    // would silently stop sharing them
+    if (baseline.get_current_day() != intervention.get_current_day() ||
+        first.get_day() != second.get_day() ||
+        first.get_random_epoch() != second.get_random_epoch()) {
+        throw std::invalid_argument("Paired models must be on the same day and random epoch");
+    }
+    if (days < -1) {
+        throw std::invalid_argument("Days must be non-negative or -1");
+    }
+
+    int remain_days = std::min(baseline.get_remain_days(), intervention.get_remain_days());
+    days = (days == -1) ? remain_days : std::min(days, remain_days);
+    if (days <= 0) return false;
+
+    // Restores the verbosity of a model when the paired run ends, also when simulate throws
+    struct VerboseGuard {
+        Model &model;  ///< Model whose progress bar is silenced
+        bool verbose;  ///< Verbosity to restore
+        ~VerboseGuard() { model.set_verbose(verbose); }
+    };
+
+    // Advance both models one day at a time so neither runs ahead of the other
+    bool verbose = baseline.get_verbose() || intervention.get_verbose();
+    VerboseGuard baseline_guard{baseline, baseline.get_verbose()};
+    VerboseGuard intervention_guard{intervention, intervention.get_verbose()};
+    baseline.set_verbose(false);
+    intervention.set_verbose(false);
+
+    if (verbose) print_progress_bar(0, days);
+    const int update_interval = std::max(1, days / 10);
+    for (int d = 1; d <= days; ++d) {
+        baseline.simulate(1, baseline_schedule);
+        intervention.simulate(1, intervention_schedule);
+        if (verbose && (d % update_interval == 0 || d == days)) {
+            print_progress_bar(d, days);
+        }
+    }
+    if (verbose) std::cout << std::endl;
+    return true;
+}
+
 void print_progress_bar(int progress, int total, int bar_width) {
     float percent = 100.0f * progress / total;
     int filled = static_cast<int>(percent * bar_width / 100.0f);
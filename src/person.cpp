@@ -1,14 +1,17 @@
 #include "person.h"
 
-#include <random>
+#include <algorithm>
+#include <cstdint>
 #include <stdexcept>
 #include <utility>
 
+#include "class_table.h"
 #include "disease.h"
+#include "random.h"
 
 Person::Person(int i, int j) : i(i), j(j), status(Status::Susceptible) {}
 
-bool Person::incubate(int days_in_incubation) {
+bool Person::incubate(int days_in_incubation, int strain) {
     // Only when Status is Susceptible
     if (status != Status::Susceptible) {
         return false;
@@ -16,6 +19,19 @@ bool Person::incubate(int days_in_incubation) {
     status = Status::Incubated;
     remain_incubated_days = days_in_incubation;
     remain_infected_days = -1;
+    this->strain = strain;
+    return true;
+}
+
+bool Person::reinfect(int days_in_incubation, int strain) {
+    // Only when Status is Recovered, the caller decides whether immunity was escaped
+    if (status != Status::Recovered) {
+        return false;
+    }
+    status = Status::Incubated;
+    remain_incubated_days = days_in_incubation;
+    remain_infected_days = -1;
+    this->strain = strain;
     return true;
 }
 
@@ -38,6 +54,7 @@ bool Person::recover() {
     status = Status::Recovered;
     remain_incubated_days = 0;
     remain_infected_days = 0;
+    immunity |= uint32_t(1) << strain;
     return true;
 }
 
@@ -52,7 +69,37 @@ bool Person::die() {
     return true;
 }
 
-void Person::update(const Disease *disease, std::mt19937 &rng) {
+bool Person::vaccinate() {
+    // Only when Status is Susceptible
+    if (status != Status::Susceptible) {
+        return false;
+    }
+    status = Status::Recovered;
+    remain_incubated_days = 0;
+    remain_infected_days = 0;
+    immunity = ~uint32_t(0);
+    return true;
+}
+
+bool Person::isolate(int days) {
+    // NOTE: Dead people have nobody left to meet
+    if (status == Status::Dead || days <= 0) {
+        return false;
+    }
+    bool was_isolated = is_isolated();
+    remain_isolated_days = std::max(remain_isolated_days, days);
+    return !was_isolated;
+}
+
+bool Person::update_isolation() {
+    if (remain_isolated_days > 0) {
+        remain_isolated_days -= 1;
+    }
+    return is_isolated();
+}
+
+void Person::update(const Disease *disease, Random &random, int day, int cell,
+                    const ClassParameters *parameters) {
     if (disease == nullptr) {
         throw std::invalid_argument("Disease pointer cannot be null");
     }
@@ -66,7 +113,9 @@ void Person::update(const Disease *disease, std::mt19937 &rng) {
                 remain_incubated_days -= 1;
             }
             if (remain_incubated_days == 0) {
-                infect(disease->get_days_with_symptoms());
+                // NOTE: A class, when given, overrides the disease durations and fatality
+                infect(parameters ? parameters->days_with_symptoms
+                                  : disease->get_days_with_symptoms());
             }
             break;
         case Status::Infected:
@@ -75,7 +124,9 @@ void Person::update(const Disease *disease, std::mt19937 &rng) {
             }
             if (remain_infected_days == 0) {
                 // A Person has a small chance being dead
-                if (get_chance(rng) < disease->get_fatality_rate()) {
+                double fatality_rate =
+                    parameters ? parameters->fatality_rate : disease->get_fatality_rate();
+                if (random.chance(day, cell, Purpose::Fatality, 0) < fatality_rate) {
                     die();
                 } else {
                     recover();
@@ -103,10 +154,22 @@ bool Person::is_removed() const {
     return status == Status::Recovered || status == Status::Dead;
 }
 
+bool Person::is_isolated() const {
+    return remain_isolated_days > 0;
+}
+
 Status Person::get_status() const {
     return status;
 }
 
+int Person::get_strain() const {
+    return strain;
+}
+
+uint32_t Person::get_immunity() const {
+    return immunity;
+}
+
 char Person::get_symbol() const {
     switch (status) {
         case Status::Susceptible:
@@ -127,8 +190,3 @@ char Person::get_symbol() const {
 std::pair<int, int> Person::get_position() const {
     return std::make_pair(i, j);
 }
-
-double Person::get_chance(std::mt19937 &rng) const {
-    std::uniform_real_distribution<double> dist(0.0, 1.0);
-    return dist(rng);
-}
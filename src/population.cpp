@@ -1,26 +1,65 @@
 #include "population.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <memory>
 #include <random>
 #include <stdexcept>
 #include <string>
 #include <vector>
 
+#include "class_table.h"
 #include "disease.h"
+#include "layout.h"
+#include "memory.h"
 #include "person.h"
+#include "random.h"
+#include "raster.h"
+#include "topology.h"
+
+// Build the topology a standalone Population owns, sampling neighbors on the fly if the table
+// would break the memory cap
+static std::shared_ptr<const Topology> make_topology(int size, int travel_radius,
+                                                     size_t memory_cap) {
+    bool neighbor_cache = true;
+    // NOTE: Check the budget before allocating anything
+    if (memory_cap > 0) {
+        MemoryUsage usage = Population::estimate_memory(size, travel_radius, true);
+        if (usage.total() > memory_cap) {
+            neighbor_cache = false;
+            usage = Population::estimate_memory(size, travel_radius, false);
+        }
+        if (usage.total() > memory_cap) {
+            throw std::invalid_argument("Population needs " + usage.describe() +
+                                        ", over the memory cap of " + format_bytes(memory_cap));
+        }
+    }
+    return std::make_shared<Topology>(size, travel_radius, Layout::RowMajor, 16, neighbor_cache);
+}
 
 Population::Population(int size, int travel_radius, int encounters, int init_incubations,
                        int init_infections, std::shared_ptr<Disease> disease, unsigned int seed,
-                       const std::string &name)
-    : size(size),
-      travel_radius(travel_radius),
-      encounters(encounters),
-      disease(std::move(disease)),
-      name(name),
+                       const std::string &name, RandomMode random_mode, size_t memory_cap)
+    : Population(make_topology(size, travel_radius, memory_cap), encounters, init_incubations,
+                 init_infections, std::move(disease), seed, name, random_mode) {}
+
+Population::Population(std::shared_ptr<const Topology> topology, int encounters,
+                       int init_incubations, int init_infections, std::shared_ptr<Disease> disease,
+                       unsigned int seed, const std::string &name, RandomMode random_mode)
+    : encounters(encounters),
       init_incubations(init_incubations),
-      init_infections(init_infections) {
+      init_infections(init_infections),
+      name(name),
+      disease(std::move(disease)),
+      topology(std::move(topology)) {
     // Validate arguments
+    if (this->topology.get() == nullptr) {
+        throw std::invalid_argument("Topology shared pointer cannot be null");
+    }
+    size = this->topology->get_size();
     if (this->disease.get() == nullptr) {
         throw std::invalid_argument("Disase shared pointer cannot be null");
     }
@@ -39,182 +78,316 @@ Population::Population(int size, int travel_radius, int encounters, int init_inc
     // Initalize the random number generator
     std::random_device rd;
     this->seed = (seed == 0) ? rd() : seed;
-    rng.seed(this->seed);
+    random.reseed(this->seed);
+    random.set_mode(random_mode);
 
     // Initialize status counts
     status_count.resize(5, 0);
 
-    // Initialize grid of people
-    people.resize(size);
-    for (int i = 0; i < size; ++i) {
-        people[i].resize(size);
-        for (int j = 0; j < size; ++j) {
-            people[i][j] = std::make_unique<Person>(i, j);
-        }
-    }
+    // The disease is strain 0, fully protecting those who recovered from it
+    strains.push_back(this->disease);
+    cross_immunity.assign(1, 1.0);
+    strain_counts.assign(3, 0);
 
-    // Precompute neighbors for each cell (i, j)
-    neighbors.resize(size, std::vector<std::vector<Person *>>(size));
-    for (int i = 0; i < size; ++i) {
-        for (int j = 0; j < size; ++j) {
-            for (int di = -travel_radius; di <= travel_radius; ++di) {
-                for (int dj = -travel_radius; dj <= travel_radius; ++dj) {
-                    int ni = i + di;
-                    int nj = j + dj;
-                    if (ni >= 0 && ni < size && nj >= 0 && nj < size && !(di == 0 && dj == 0)) {
-                        neighbors[i][j].push_back(people[ni][nj].get());
-                    }
-                }
-            }
-        }
-    }
+    // Initialize grid of people
+    // NOTE: Only per-person state is allocated, the neighbor table belongs to the topology
+    build_people();
+    zone_counts.assign(static_cast<size_t>(this->topology->get_zone_count()) * 5, 0);
 
     // Initialize some Incubations and Infections at start
     std::vector<Person *> candidates = flatten();
-    std::vector<Person *> incubations = sample(candidates, init_incubations);
-    std::vector<Person *> infections = sample(incubations, init_infections);
+    std::vector<Person *> incubations = sample(candidates, init_incubations, Purpose::Incubation);
+    std::vector<Person *> infections = sample(incubations, init_infections, Purpose::Infection);
 
     // NOTE: Missing "this" has caused a severe bug here!
     for (auto person : incubations) {
-        person->incubate(this->disease->get_days_in_incubation());
+        person->incubate(get_days_in_incubation(person));
     }
     for (auto person : infections) {
-        person->infect(this->disease->get_days_with_symptoms());
+        person->infect(get_days_with_symptoms(person));
     }
 
     // Update status count and current infectious people
     // NOTE: At peak infectious people counts will be equal to the population size
     infectious_people.reserve(size * size);
-    for (int i = 0; i < size; ++i) {
-        for (int j = 0; j < size; ++j) {
-            Person *person = people[i][j].get();
-            if (person == nullptr) continue;
+    for (int cell = 0; cell < size * size; ++cell) {
+        Person *person = at(cell);
 
-            Status status = person->get_status();
-            status_count[static_cast<int>(status)] += 1;
+        Status status = person->get_status();
+        status_count[static_cast<int>(status)] += 1;
 
-            if (person->is_infectious()) {
-                infectious_people.push_back(person);
-            }
+        if (person->is_infectious()) {
+            infectious_people.push_back(person);
         }
     }
+    count_zones();
+    count_strains();
 }
 
 void Population::update() {
-    // NOTE: Stop early if the population is already stable
-    if (infectious_people.empty()) return;
-
-    std::vector<int> new_status_count(status_count.size(), 0);
-    std::vector<Person *> new_infectious_people;
+    new_infections.clear();
+    infectors = 0;
+    day += 1;
 
-    // Phase 1: Update statuses and collect new infectious people
-    for (int i = 0; i < size; ++i) {
-        for (int j = 0; j < size; ++j) {
-            Person *person = people[i][j].get();
-            if (person == nullptr) continue;
-            person->update(disease.get(), rng);
-        }
+    // NOTE: Stop early if the population is already stable
+    if (infectious_people.empty()) {
+        update_isolation();
+        return;
     }
 
-    // Phase 2: Process interactions for previous infectious people
+    // Phase 1: Update statuses of infectious people
+    // NOTE: Nobody else changes on their own, and the list is in row-major order like a full scan
     for (Person *person : infectious_people) {
-        // NOTE: Add this to reduce the spread of the disease for lower transmission rate
-        // if (get_chance() > disease->get_transmission_rate()) {
-        //     continue;
-        // }
-        std::pair<int, int> pos = person->get_position();
-        int i = pos.first, j = pos.second;
+        Status before = person->get_status();
+        person->update(strains[person->get_strain()].get(), random, day, cell_of(person),
+                       get_parameters(person));
+        Status after = person->get_status();
+        if (after != before) count_transition(person, before, after);
+    }
 
-        std::vector<Person *> targets = get_encountered(i, j);
-        for (Person *neighbor : targets) {
-            interact(person, neighbor);
-        }
+    // NOTE: Collected before spreading, a carrier who recovered above may be reinfected below by
+    // another strain and must then only come back through new_infections
+    std::vector<Person *> still_infectious;
+    still_infectious.reserve(infectious_people.size());
+    for (Person *person : infectious_people) {
+        if (person->is_infectious()) still_infectious.push_back(person);
     }
 
-    // Phase 3: Collect the new infectious people and update new status counts
-    for (int i = 0; i < size; ++i) {
-        for (int j = 0; j < size; ++j) {
-            Person *person = people[i][j].get();
-            if (person->is_infectious()) {
-                new_infectious_people.push_back(person);
-            }
-            Status status = person->get_status();
-            new_status_count[static_cast<int>(status)] += 1;
-        }
+    // Phase 2: Process interactions for previous infectious people
+    // NOTE: All strains spread in the same pass, each carrier uses the parameters of its own
+    if (batched) {
+        spread_batched();
+    } else {
+        spread();
     }
 
-    infectious_people = new_infectious_people;
-    status_count = new_status_count;
+    // Phase 3: Merge people still infectious with the newly infected, keeping row-major order
+    auto by_cell = [this](const Person *a, const Person *b) { return cell_of(a) < cell_of(b); };
+    std::vector<Person *> sorted_infections = new_infections;
+    std::sort(sorted_infections.begin(), sorted_infections.end(), by_cell);
+
+    infectious_people.clear();
+    std::merge(still_infectious.begin(), still_infectious.end(), sorted_infections.begin(),
+               sorted_infections.end(), std::back_inserter(infectious_people), by_cell);
+
+    update_isolation();
 }
 
 void Population::reset(bool same_seed) {
     // Reset RNG for deterministically behavior
     if (same_seed) {
-        rng.seed(this->seed);
+        random.reseed(this->seed);
+    } else {
+        random.restart();
     }
 
     // Reset people grid
-    people.clear();
-    people.resize(size);
-    for (int i = 0; i < size; ++i) {
-        people[i].resize(size);
-        for (int j = 0; j < size; ++j) {
-            people[i][j] = std::make_unique<Person>(i, j);
-        }
-    }
-
-    // Recompute neighbors
-    // NOTE: Clear people left the neighbor pointers become dangling
-    neighbors.clear();
-    neighbors.resize(size, std::vector<std::vector<Person *>>(size));
-    for (int i = 0; i < size; ++i) {
-        for (int j = 0; j < size; ++j) {
-            for (int di = -travel_radius; di <= travel_radius; ++di) {
-                for (int dj = -travel_radius; dj <= travel_radius; ++dj) {
-                    int ni = i + di;
-                    int nj = j + dj;
-                    if (ni >= 0 && ni < size && nj >= 0 && nj < size && !(di == 0 && dj == 0)) {
-                        neighbors[i][j].push_back(people[ni][nj].get());
-                    }
-                }
-            }
-        }
-    }
+    build_people();
 
     // Reset tracking information
     status_count.clear();
     status_count.resize(5, 0);
     infectious_people.clear();
+    isolated_people.clear();
+    new_infections.clear();
+    infectors = 0;
+    day = 0;
+    // NOTE: Start a fresh log rather than clearing, exported views may still point into the old one
+    if (transmission_log) transmission_log = std::make_shared<TransmissionLog>();
 
     // Apply initial statuses
     // NOTE: Recreate initial state by calling sample to achieve the same RNG state
     std::vector<Person *> candidates = flatten();
-    std::vector<Person *> incubations = sample(candidates, init_incubations);
-    std::vector<Person *> infections = sample(incubations, init_infections);
+    std::vector<Person *> incubations = sample(candidates, init_incubations, Purpose::Incubation);
+    std::vector<Person *> infections = sample(incubations, init_infections, Purpose::Infection);
 
     // Apply statuses to selected people
     // NOTE: Missing "this" has caused a severe bug in the constructor
     for (auto person : incubations) {
-        person->incubate(disease->get_days_in_incubation());
+        person->incubate(get_days_in_incubation(person));
     }
     for (auto person : infections) {
-        person->infect(disease->get_days_with_symptoms());
+        person->infect(get_days_with_symptoms(person));
     }
 
     // Update status count and current infectious people
-    for (int i = 0; i < size; ++i) {
-        for (int j = 0; j < size; ++j) {
-            Person *person = people[i][j].get();
-            if (person == nullptr) continue;
+    for (int cell = 0; cell < size * size; ++cell) {
+        Person *person = at(cell);
 
-            Status status = person->get_status();
-            status_count[static_cast<int>(status)] += 1;
+        Status status = person->get_status();
+        status_count[static_cast<int>(status)] += 1;
 
-            if (person->is_infectious()) {
-                infectious_people.push_back(person);
-            }
+        if (person->is_infectious()) {
+            infectious_people.push_back(person);
+        }
+    }
+    count_zones();
+    count_strains();
+}
+
+int Population::vaccinate(const std::vector<int> &cells) {
+    validate_cells(cells);
+
+    int count = 0;
+    for (int cell : cells) {
+        Person *person = at(cell);
+        if (person != nullptr && person->vaccinate()) {
+            count_transition(person, Status::Susceptible, Status::Recovered);
+            count += 1;
         }
     }
+    return count;
+}
+
+int Population::seed_incubations(const std::vector<int> &cells, int strain) {
+    validate_strain(strain);
+    validate_cells(cells);
+
+    int count = 0;
+    for (int cell : cells) {
+        Person *person = at(cell);
+        if (person != nullptr && person->incubate(get_days_in_incubation(person, strain), strain)) {
+            count_transition(person, Status::Susceptible, Status::Incubated);
+            infectious_people.push_back(person);
+            count += 1;
+        }
+    }
+
+    // NOTE: Keep the infectious list in row-major order, update() relies on it
+    std::sort(infectious_people.begin(), infectious_people.end(),
+              [this](const Person *a, const Person *b) { return cell_of(a) < cell_of(b); });
+    return count;
+}
+
+int Population::isolate(const std::vector<int> &cells, int days) {
+    if (days < 0) {
+        throw std::invalid_argument("Isolation days must be non-negative");
+    }
+    validate_cells(cells);
+
+    int count = 0;
+    for (int cell : cells) {
+        Person *person = at(cell);
+        if (person != nullptr && person->isolate(days)) {
+            isolated_people.push_back(person);
+            count += 1;
+        }
+    }
+    return count;
+}
+
+void Population::set_classes(const std::vector<uint8_t> &classes,
+                             std::shared_ptr<ClassTable> table) {
+    set_topology(topology->with_classes(classes, std::move(table)));
+}
+
+void Population::load_classes(const std::string &path, std::shared_ptr<ClassTable> table) {
+    int height = 0, width = 0;
+    std::vector<int> raster = read_pgm(path, height, width);
+    if (height != size || width != size) {
+        throw std::invalid_argument("Class raster must be size x size: " + path);
+    }
+
+    std::vector<uint8_t> values(raster.size());
+    for (size_t k = 0; k < raster.size(); ++k) {
+        if (raster[k] > 255) {
+            throw std::invalid_argument("Class raster values must fit in a byte: " + path);
+        }
+        values[k] = static_cast<uint8_t>(raster[k]);
+    }
+    set_classes(values, std::move(table));
+}
+
+void Population::clear_classes() {
+    set_topology(topology->without_classes());
+}
+
+void Population::set_zones(const std::vector<int> &zones) {
+    set_topology(topology->with_zones(zones));
+}
+
+void Population::load_zones(const std::string &path) {
+    int height = 0, width = 0;
+    std::vector<int> raster = read_pgm(path, height, width);
+    if (height != size || width != size) {
+        throw std::invalid_argument("Zone raster must be size x size: " + path);
+    }
+    set_zones(raster);
+}
+
+void Population::clear_zones() {
+    set_topology(topology->without_zones());
+}
+
+void Population::set_layout(Layout layout, int tile) {
+    if (tile <= 0) {
+        throw std::invalid_argument("Tile size must be positive");
+    }
+    if (layout == topology->get_layout() && tile == topology->get_tile()) return;
+    set_topology(topology->with_layout(layout, tile));
+}
+
+int Population::add_strain(std::shared_ptr<Disease> disease, double cross_immunity) {
+    if (disease.get() == nullptr) {
+        throw std::invalid_argument("Disease shared pointer cannot be null");
+    }
+    if (cross_immunity < 0.0 || cross_immunity > 1.0) {
+        throw std::invalid_argument("Cross immunity must be between 0 and 1");
+    }
+    if (static_cast<int>(strains.size()) >= MAX_STRAINS) {
+        throw std::invalid_argument("Too many strains");
+    }
+
+    // Grow the matrix by one row and column, recovering from a strain always protects against it
+    int n = static_cast<int>(strains.size());
+    std::vector<double> matrix((n + 1) * (n + 1), cross_immunity);
+    for (int from = 0; from < n; ++from) {
+        for (int to = 0; to < n; ++to) {
+            matrix[from * (n + 1) + to] = this->cross_immunity[from * n + to];
+        }
+    }
+    matrix[n * (n + 1) + n] = 1.0;
+    this->cross_immunity.swap(matrix);
+
+    strains.push_back(std::move(disease));
+    strain_counts.resize(strains.size() * 3, 0);
+    return n;
+}
+
+void Population::set_cross_immunity(int from, int to, double protection) {
+    validate_strain(from);
+    validate_strain(to);
+    if (protection < 0.0 || protection > 1.0) {
+        throw std::invalid_argument("Cross immunity must be between 0 and 1");
+    }
+    cross_immunity[from * strains.size() + to] = protection;
+}
+
+void Population::set_random_mode(RandomMode mode) {
+    random.set_mode(mode);
+}
+
+void Population::set_neighbor_cache(bool enabled) {
+    if (enabled == topology->get_neighbor_cache()) return;
+    set_topology(topology->with_neighbor_cache(enabled));
+}
+
+void Population::set_batched(bool enabled) {
+    // NOTE: Sequential draws are taken in a different order when batched, so only keyed draws
+    // give the same results both ways
+    batched = enabled;
+    if (!batched) {
+        encounter_list = std::vector<Encounter>();
+        encounter_swap = std::vector<Encounter>();
+    }
+}
+
+void Population::enable_transmission_log() {
+    if (!transmission_log) transmission_log = std::make_shared<TransmissionLog>();
+}
+
+void Population::disable_transmission_log() {
+    transmission_log.reset();
 }
 
 std::vector<std::vector<int>> Population::get_people() const {
@@ -223,30 +396,181 @@ std::vector<std::vector<int>> Population::get_people() const {
 
     for (int i = 0; i < size; ++i) {
         for (int j = 0; j < size; ++j) {
-            if (people[i][j].get() == nullptr) continue;
-            Status status = people[i][j]->get_status();
+            Status status = at(i * size + j)->get_status();
             grid[i][j] = static_cast<int>(status);
         }
     }
     return grid;
 }
 
+std::vector<std::vector<int>> Population::get_people(int row, int col, int height,
+                                                     int width) const {
+    if (row < 0 || col < 0 || height < 0 || width < 0 || row + height > size ||
+        col + width > size) {
+        throw std::invalid_argument("Region must lie within the grid");
+    }
+    std::vector<std::vector<int>> grid;
+    grid.resize(height, std::vector<int>(width, 0));
+
+    for (int i = 0; i < height; ++i) {
+        for (int j = 0; j < width; ++j) {
+            const Person *person = at((row + i) * size + col + j);
+            grid[i][j] = static_cast<int>(person->get_status());
+        }
+    }
+    return grid;
+}
+
+std::vector<std::vector<int>> Population::get_strain_grid() const {
+    std::vector<std::vector<int>> grid;
+    grid.resize(size, std::vector<int>(size, -1));
+
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            grid[i][j] = at(i * size + j)->get_strain();
+        }
+    }
+    return grid;
+}
+
+void Population::copy_statuses(uint8_t *out, int row, int col, int height, int width) const {
+    if (row < 0 || col < 0 || height < 0 || width < 0 || row + height > size ||
+        col + width > size) {
+        throw std::invalid_argument("Region must lie within the grid");
+    }
+    for (int i = 0; i < height; ++i) {
+        for (int j = 0; j < width; ++j) {
+            *out++ = static_cast<uint8_t>(at((row + i) * size + col + j)->get_status());
+        }
+    }
+}
+
 const std::vector<int> &Population::get_status_count() const {
     return status_count;
 }
 
+const std::vector<Person *> &Population::get_infectious_people() const {
+    return infectious_people;
+}
+
+const std::vector<Person *> &Population::get_new_infections() const {
+    return new_infections;
+}
+
+int Population::get_infectors() const {
+    return infectors;
+}
+
+int Population::get_day() const {
+    return day;
+}
+
+std::shared_ptr<TransmissionLog> Population::get_transmission_log() const {
+    return transmission_log;
+}
+
+std::shared_ptr<const Topology> Population::get_topology() const {
+    return topology;
+}
+
 int Population::get_size() const {
     return size;
 }
 
 int Population::get_travel_radius() const {
-    return travel_radius;
+    return topology->get_travel_radius();
 }
 
 int Population::get_encounters() const {
     return encounters;
 }
 
+std::shared_ptr<Disease> Population::get_disease() const {
+    return disease;
+}
+
+int Population::get_strain_count() const {
+    return static_cast<int>(strains.size());
+}
+
+std::shared_ptr<Disease> Population::get_strain(int strain) const {
+    validate_strain(strain);
+    return strains[strain];
+}
+
+double Population::get_cross_immunity(int from, int to) const {
+    validate_strain(from);
+    validate_strain(to);
+    return cross_immunity[from * strains.size() + to];
+}
+
+const std::vector<int> &Population::get_strain_counts() const {
+    return strain_counts;
+}
+
+const std::vector<int> &Population::get_zones() const {
+    return topology->get_zones();
+}
+
+int Population::get_zone_count() const {
+    return topology->get_zone_count();
+}
+
+const std::vector<int> &Population::get_zone_counts() const {
+    return zone_counts;
+}
+
+const std::vector<uint8_t> &Population::get_classes() const {
+    return topology->get_classes();
+}
+
+std::shared_ptr<ClassTable> Population::get_class_table() const {
+    return topology->get_class_table();
+}
+
+Layout Population::get_layout() const {
+    return topology->get_layout();
+}
+
+int Population::get_tile() const {
+    return topology->get_tile();
+}
+
+bool Population::get_batched() const {
+    return batched;
+}
+
+RandomMode Population::get_random_mode() const {
+    return random.get_mode();
+}
+
+uint64_t Population::get_random_epoch() const {
+    return random.get_epoch();
+}
+
+bool Population::get_neighbor_cache() const {
+    return topology->get_neighbor_cache();
+}
+
+MemoryUsage Population::get_memory(bool include_topology) const {
+    // NOTE: A shared topology is counted in full by every Population that includes it
+    MemoryUsage usage = include_topology ? topology->get_memory() : MemoryUsage();
+    usage.people = people.capacity() * sizeof(Person);
+    usage.infectious = (infectious_people.capacity() + isolated_people.capacity() +
+                        new_infections.capacity()) *
+                       sizeof(Person *);
+    usage.infectious += (encounter_list.capacity() + encounter_swap.capacity()) * sizeof(Encounter);
+    usage.tables += zone_counts.capacity() * sizeof(int) +
+                    strains.capacity() * sizeof(std::shared_ptr<Disease>) +
+                    cross_immunity.capacity() * sizeof(double) +
+                    strain_counts.capacity() * sizeof(int);
+    if (transmission_log) {
+        usage.log = transmission_log->get_chunk_count() * TransmissionLog::CHUNK_SIZE * 3 *
+                    sizeof(uint32_t);
+    }
+    return usage;
+}
+
 std::string Population::get_name() const {
     return name;
 }
@@ -256,8 +580,12 @@ unsigned int Population::get_seed() const {
 }
 
 void Population::set_travel_radius(int radius) {
-    travel_radius = radius;
-    validate();
+    if (radius < 0) {
+        throw std::invalid_argument("Travel radius must be non-negative");
+    }
+    // NOTE: Neighbors were precomputed for the old radius
+    if (radius == topology->get_travel_radius()) return;
+    set_topology(topology->with_travel_radius(radius));
 }
 
 void Population::set_encounters(int encounters) {
@@ -265,6 +593,18 @@ void Population::set_encounters(int encounters) {
     validate();
 }
 
+void Population::set_transmission_rate(double rate) {
+    override_disease().set_transmission_rate(rate);
+}
+
+void Population::set_fatality_rate(double rate) {
+    override_disease().set_fatality_rate(rate);
+}
+
+void Population::clear_disease_overrides() {
+    strains[0] = disease;
+}
+
 void Population::set_name(const std::string &name) {
     this->name = name;
 }
@@ -273,13 +613,22 @@ void Population::set_seed(unsigned int seed) {
     this->seed = seed;
 }
 
+MemoryUsage Population::estimate_memory(int size, int travel_radius, bool neighbor_cache,
+                                       int batched_encounters) {
+    MemoryUsage usage = Topology::estimate_memory(size, travel_radius, neighbor_cache);
+    size_t cells = static_cast<size_t>(size) * size;
+    usage.people = cells * sizeof(Person);
+    // NOTE: The infectious list is reserved for the whole grid, it can all be infectious at peak.
+    // The newly infected list grows on demand, up to everyone catching it on one day.
+    usage.infectious = 2 * cells * sizeof(Person *);
+    // NOTE: So can the batched encounter list and its sorting scratch, one entry per encounter
+    usage.infectious += 2 * cells * static_cast<size_t>(std::max(batched_encounters, 0)) *
+                        sizeof(Encounter);
+    usage.tables += sizeof(std::shared_ptr<Disease>) + sizeof(double) + 3 * sizeof(int);
+    return usage;
+}
+
 void Population::validate() const {
-    if (size <= 0) {
-        throw std::invalid_argument("Size must be positive");
-    }
-    if (travel_radius < 0) {
-        throw std::invalid_argument("Travel radius must be non-negative");
-    }
     if (encounters < 0) {
         throw std::invalid_argument("Encounters must be non-negative");
     }
@@ -288,31 +637,184 @@ void Population::validate() const {
     }
 }
 
-std::vector<Person *> Population::flatten() const {
+Disease &Population::override_disease() {
+    // NOTE: The disease may be shared with other populations, so only a private copy is changed
+    if (strains[0] == disease) strains[0] = std::make_shared<Disease>(*disease);
+    return *strains[0];
+}
+
+void Population::validate_cells(const std::vector<int> &cells) const {
+    // NOTE: Check everything up front so a bad index never leaves a half-applied intervention
+    for (int cell : cells) {
+        if (cell < 0 || cell >= size * size) {
+            throw std::invalid_argument("Cell index out of range");
+        }
+    }
+}
+
+Person *Population::at(int cell) {
+    return &people[topology->get_slots()[cell]];
+}
+
+const Person *Population::at(int cell) const {
+    return &people[topology->get_slots()[cell]];
+}
+
+int Population::cell_of(const Person *person) const {
+    std::pair<int, int> pos = person->get_position();
+    return pos.first * size + pos.second;
+}
+
+void Population::count_transition(const Person *person, Status from, Status to) {
+    status_count[static_cast<int>(from)] -= 1;
+    status_count[static_cast<int>(to)] += 1;
+
+    // NOTE: A person's strain only changes on infection, so it is already the new one here
+    int strain = person->get_strain();
+    if (strain >= 0) {
+        int base = strain * 3;
+        if (from == Status::Incubated) strain_counts[base] -= 1;
+        if (from == Status::Infected) strain_counts[base + 1] -= 1;
+        if (to == Status::Incubated) {
+            strain_counts[base] += 1;
+            strain_counts[base + 2] += 1;
+        }
+        if (to == Status::Infected) strain_counts[base + 1] += 1;
+    }
+
+    const std::vector<int> &zones = topology->get_zones();
+    if (zones.empty()) return;
+    int base = zones[cell_of(person)] * 5;
+    zone_counts[base + static_cast<int>(from)] -= 1;
+    zone_counts[base + static_cast<int>(to)] += 1;
+}
+
+void Population::count_zones() {
+    // NOTE: Full scan, only needed when zones are assigned or the population is reset
+    std::fill(zone_counts.begin(), zone_counts.end(), 0);
+    const std::vector<int> &zones = topology->get_zones();
+    if (zones.empty()) return;
+    for (int cell = 0; cell < size * size; ++cell) {
+        zone_counts[zones[cell] * 5 + static_cast<int>(at(cell)->get_status())] += 1;
+    }
+}
+
+void Population::count_strains() {
+    // NOTE: Full scan, only needed when the population is built or reset
+    std::fill(strain_counts.begin(), strain_counts.end(), 0);
+    for (int cell = 0; cell < size * size; ++cell) {
+        const Person *person = at(cell);
+        if (person->get_strain() < 0) continue;
+        int base = person->get_strain() * 3;
+        if (person->get_status() == Status::Incubated) strain_counts[base] += 1;
+        if (person->get_status() == Status::Infected) strain_counts[base + 1] += 1;
+        strain_counts[base + 2] += 1;
+    }
+}
+
+void Population::validate_strain(int strain) const {
+    if (strain < 0 || strain >= static_cast<int>(strains.size())) {
+        throw std::invalid_argument("Strain index out of range");
+    }
+}
+
+void Population::update_isolation() {
+    // NOTE: Released people are swapped out, order of the isolated list does not matter
+    for (size_t k = 0; k < isolated_people.size();) {
+        if (isolated_people[k]->update_isolation()) {
+            ++k;
+        } else {
+            isolated_people[k] = isolated_people.back();
+            isolated_people.pop_back();
+        }
+    }
+}
+
+void Population::build_people() {
+    const std::vector<int> &order = topology->get_order();
+    people.clear();
+    people.reserve(order.size());
+    for (int cell : order) {
+        people.emplace_back(cell / size, cell % size);
+    }
+}
+
+void Population::set_topology(std::shared_ptr<const Topology> topology) {
+    // Move everyone into the new order if it changed, keeping their state
+    if (topology->get_order() != this->topology->get_order()) {
+        std::vector<Person> moved;
+        moved.reserve(people.size());
+        for (int cell : topology->get_order()) {
+            moved.push_back(*at(cell));
+        }
+        people.swap(moved);
+        this->topology = std::move(topology);
+
+        // NOTE: Tracked pointers point into the old storage, look them up again by cell
+        for (std::vector<Person *> *tracked :
+             {&infectious_people, &isolated_people, &new_infections}) {
+            for (Person *&person : *tracked) {
+                person = at(cell_of(person));
+            }
+        }
+    } else {
+        this->topology = std::move(topology);
+    }
+    zone_counts.assign(static_cast<size_t>(this->topology->get_zone_count()) * 5, 0);
+    count_zones();
+}
+
+const ClassParameters *Population::get_parameters(const Person *person) const {
+    return topology->get_class_parameters(cell_of(person));
+}
+
+int Population::get_days_in_incubation(const Person *person, int strain) const {
+    const ClassParameters *parameters = get_parameters(person);
+    return parameters ? parameters->days_in_incubation : strains[strain]->get_days_in_incubation();
+}
+
+int Population::get_days_with_symptoms(const Person *person, int strain) const {
+    const ClassParameters *parameters = get_parameters(person);
+    return parameters ? parameters->days_with_symptoms : strains[strain]->get_days_with_symptoms();
+}
+
+double Population::get_protection(const Person *person, int strain) const {
+    if (person->is_susceptible()) return 0.0;
+    // NOTE: Nobody carries two strains at once, and vaccination protects against every strain
+    if (person->get_status() != Status::Recovered) return 1.0;
+    uint32_t immunity = person->get_immunity();
+    if (immunity == ~uint32_t(0)) return 1.0;
+
+    // Each strain recovered from blocks the infection independently
+    double escape = 1.0;
+    size_t n = strains.size();
+    for (size_t from = 0; from < n; ++from) {
+        if (immunity & (uint32_t(1) << from)) escape *= 1.0 - cross_immunity[from * n + strain];
+    }
+    return 1.0 - escape;
+}
+
+std::vector<Person *> Population::flatten() {
+    // NOTE: Row-major whatever the layout, initial sampling depends on this order
     std::vector<Person *> flat;
     flat.reserve(size * size);
-    for (int i = 0; i < size; ++i) {
-        for (int j = 0; j < size; ++j) {
-            Person *person = people[i][j].get();
-            if (person == nullptr) continue;
-            flat.push_back(person);
-        }
+    for (int cell = 0; cell < size * size; ++cell) {
+        flat.push_back(at(cell));
     }
     return flat;
 }
 
-std::vector<Person *> Population::sample(std::vector<Person *> people, int count) const {
+std::vector<Person *> Population::sample(const std::vector<Person *> &people, int count,
+                                         Purpose purpose, int cell) const {
     std::vector<Person *> result;
     result.reserve(count);
 
     // NOTE: Should check for "count" arg
     if (people.empty() || count <= 0) return result;
 
-    std::uniform_int_distribution<> dist(0, people.size() - 1);
-
     // NOTE: Same person could appear multiple times
     for (int i = 0; i < count; ++i) {
-        int index = dist(rng);
+        int index = random.pick(static_cast<int>(people.size()), day, cell, purpose, i);
         Person *person = people[index];
         if (person == nullptr) continue;
         result.push_back(person);
@@ -320,31 +822,237 @@ std::vector<Person *> Population::sample(std::vector<Person *> people, int count
     return result;
 }
 
-std::vector<Person *> Population::get_encountered(int row, int col) const {
-    if (neighbors[row][col].empty()) {
-        return {};
+void Population::get_encountered(const Person *person, std::vector<Person *> &targets) {
+    // NOTE: Filled in place so a pass can reuse one buffer for every carrier
+    targets.clear();
+    int cell = cell_of(person);
+    if (topology->get_neighbor_cache()) {
+        int slot = topology->get_slots()[cell];
+        int count = topology->get_neighbor_count(slot);
+        if (count <= 0 || encounters <= 0) {
+            return;
+        }
+        const uint32_t *candidates = topology->get_neighbors(slot);
+        for (int k = 0; k < encounters; ++k) {
+            int index = random.pick(count, day, cell, Purpose::Encounter, k);
+            targets.push_back(&people[candidates[index]]);
+        }
+        return;
+    }
+
+    // Without the cache, pick positions in the window around the person directly
+    // NOTE: Same row-major order as the cached list, skipping the person itself, so the same
+    // draws pick the same people
+    int travel_radius = topology->get_travel_radius();
+    std::pair<int, int> pos = person->get_position();
+    int top = std::max(0, pos.first - travel_radius);
+    int left = std::max(0, pos.second - travel_radius);
+    int rows = std::min(size - 1, pos.first + travel_radius) - top + 1;
+    int cols = std::min(size - 1, pos.second + travel_radius) - left + 1;
+    int count = rows * cols - 1;
+    if (count <= 0 || encounters <= 0) {
+        return;
+    }
+    int self = (pos.first - top) * cols + (pos.second - left);
+    for (int k = 0; k < encounters; ++k) {
+        int index = random.pick(count, day, cell, Purpose::Encounter, k);
+        if (index >= self) index += 1;
+        targets.push_back(at((top + index / cols) * size + left + index % cols));
     }
-    return sample(neighbors[row][col], encounters);
 }
 
-bool Population::interact(Person *current, Person *other) {
+bool Population::interact(Person *current, Person *other, uint32_t index) {
     // NOTE: If other person is already infectious, the
     // current person cannot transfer the disease
     if (current == nullptr || other == nullptr || !current->is_infectious() ||
-        !other->is_susceptible()) {
+        other->is_isolated()) {
+        return false;
+    }
+    // NOTE: Fully protected people make no draw, so a single strain consumes the RNG as before
+    int strain = current->get_strain();
+    double protection = get_protection(other, strain);
+    if (protection >= 1.0) {
         return false;
     }
     // If the other person is not infectious, try to infect by transmission rate
-    // NOTE: Actually only when other is Susceptile
-    double transmission_rate = std::pow(disease->get_transmission_rate(), 3.0);
-    if (get_chance(rng) < transmission_rate) {
-        other->incubate(disease->get_days_in_incubation());
+    double transmission_rate = std::pow(strains[strain]->get_transmission_rate(), 3.0);
+    transmission_rate *= 1.0 - protection;
+    const ClassParameters *parameters = get_parameters(other);
+    if (parameters != nullptr) {
+        transmission_rate *= parameters->susceptibility;
+    }
+    if (random.chance(day, cell_of(current), Purpose::Transmission, index) < transmission_rate) {
+        int days = get_days_in_incubation(other, strain);
+        if (other->is_susceptible()) {
+            other->incubate(days, strain);
+        } else {
+            other->reinfect(days, strain);
+        }
         return true;
     }
     return false;
 }
 
-double Population::get_chance(std::mt19937 &rng) const {
-    std::uniform_real_distribution<double> dist(0.0, 1.0);
-    return dist(rng);
+void Population::spread() {
+    std::vector<Person *> targets;
+    for (Person *person : infectious_people) {
+        // NOTE: Isolated people make no encounters
+        if (person->is_isolated()) continue;
+        if (person->is_infectious()) infectors += 1;
+
+        // NOTE: Add this to reduce the spread of the disease for lower transmission rate
+        // if (get_chance() > disease->get_transmission_rate()) {
+        //     continue;
+        // }
+        get_encountered(person, targets);
+        for (size_t k = 0; k < targets.size(); ++k) {
+            Person *neighbor = targets[k];
+            // NOTE: Recovered people may be reinfected by another strain
+            Status before = neighbor->get_status();
+            if (interact(person, neighbor, static_cast<uint32_t>(k))) {
+                count_transition(neighbor, before, Status::Incubated);
+                new_infections.push_back(neighbor);
+                if (transmission_log) {
+                    transmission_log->record(cell_of(person), cell_of(neighbor), day);
+                }
+            }
+        }
+    }
+}
+
+void Population::spread_batched() {
+    // Gather the encounters of every carrier, in the order the per-person pass makes them
+    // NOTE: People reinfected by another strain during the pass only spread from the next day,
+    // the per-person pass lets them spread at once if they come later in the list
+    // NOTE: Reserve the bound for the day up front, growing by doubling could hold twice the
+    // estimate_memory peak in each buffer
+    size_t bound = infectious_people.size() * static_cast<size_t>(encounters);
+    encounter_list.reserve(bound);
+    encounter_swap.reserve(bound);
+    encounter_list.clear();
+    std::vector<Person *> targets;
+    for (Person *person : infectious_people) {
+        if (person->is_isolated() || !person->is_infectious()) continue;
+        infectors += 1;
+
+        uint32_t cell = static_cast<uint32_t>(cell_of(person));
+        uint32_t strain = static_cast<uint32_t>(person->get_strain());
+        get_encountered(person, targets);
+        for (size_t k = 0; k < targets.size(); ++k) {
+            uint32_t target = static_cast<uint32_t>(targets[k] - people.data());
+            encounter_list.push_back({target, cell, static_cast<uint32_t>(k), strain});
+        }
+    }
+    if (encounter_list.empty()) return;
+
+    // Group encounters by target slot, keeping the carrier order for each target
+    sort_encounters();
+
+    // Resolve each target once, walking the slots in memory order so its block stays in cache
+    // NOTE: A target's encounters are still met in carrier order, and once infected it is
+    // protected from the rest, so the first success wins exactly as in the per-person pass
+    std::vector<double> rates(strains.size());
+    for (size_t strain = 0; strain < strains.size(); ++strain) {
+        rates[strain] = std::pow(strains[strain]->get_transmission_rate(), 3.0);
+    }
+    std::vector<Encounter> infections;
+    size_t count = encounter_list.size();
+    for (size_t begin = 0, end = 0; begin < count; begin = end) {
+        uint32_t target = encounter_list[begin].target;
+        for (end = begin + 1; end < count && encounter_list[end].target == target; ++end) {
+        }
+        Person *other = &people[target];
+        if (other->is_isolated()) continue;
+        const ClassParameters *parameters = get_parameters(other);
+
+        // NOTE: Protection only depends on the strain until the target is infected
+        uint32_t protected_strain = ~uint32_t(0);
+        double protection = 1.0;
+        for (size_t e = begin; e < end; ++e) {
+            const Encounter &encounter = encounter_list[e];
+            if (encounter.strain != protected_strain) {
+                protected_strain = encounter.strain;
+                protection = get_protection(other, encounter.strain);
+            }
+            if (protection >= 1.0) continue;
+
+            double transmission_rate = rates[encounter.strain];
+            transmission_rate *= 1.0 - protection;
+            if (parameters != nullptr) {
+                transmission_rate *= parameters->susceptibility;
+            }
+            int cell = static_cast<int>(encounter.cell);
+            if (random.chance(day, cell, Purpose::Transmission, encounter.index) >=
+                transmission_rate) {
+                continue;
+            }
+            int strain = static_cast<int>(encounter.strain);
+            Status before = other->get_status();
+            int days = get_days_in_incubation(other, strain);
+            if (other->is_susceptible()) {
+                other->incubate(days, strain);
+            } else {
+                other->reinfect(days, strain);
+            }
+            count_transition(other, before, Status::Incubated);
+            infections.push_back(encounter);
+            break;
+        }
+    }
+
+    // Report infections in the order the per-person pass finds them
+    std::sort(infections.begin(), infections.end(), [](const Encounter &a, const Encounter &b) {
+        return a.cell != b.cell ? a.cell < b.cell : a.index < b.index;
+    });
+    for (const Encounter &infection : infections) {
+        Person *other = &people[infection.target];
+        new_infections.push_back(other);
+        if (transmission_log) {
+            transmission_log->record(infection.cell, cell_of(other), day);
+        }
+    }
+}
+
+void Population::sort_encounters() {
+    // Stable counting sort on the block of the target slot, then on the slot within each block
+    // NOTE: A block of 1024 slots holds 32 KiB of Persons, small enough to stay in cache, and its
+    // second pass only touches that block's encounters and a 1024-entry count table
+    constexpr int BLOCK_BITS = 10;
+    constexpr uint32_t SLOT_MASK = (uint32_t(1) << BLOCK_BITS) - 1;
+    size_t blocks = ((people.size() - 1) >> BLOCK_BITS) + 1;
+    std::vector<size_t> offsets(blocks + 1, 0);
+    for (const Encounter &encounter : encounter_list) {
+        offsets[(encounter.target >> BLOCK_BITS) + 1] += 1;
+    }
+    for (size_t block = 1; block <= blocks; ++block) {
+        offsets[block] += offsets[block - 1];
+    }
+    std::vector<size_t> starts(offsets.begin(), offsets.end() - 1);
+    encounter_swap.resize(encounter_list.size());
+    for (const Encounter &encounter : encounter_list) {
+        encounter_swap[starts[encounter.target >> BLOCK_BITS]++] = encounter;
+    }
+
+    // Scatter each block back by slot, so every target's encounters end up next to each other
+    std::vector<size_t> slots(SLOT_MASK + 2);
+    for (size_t block = 0; block < blocks; ++block) {
+        size_t begin = offsets[block];
+        size_t end = offsets[block + 1];
+        if (end - begin < 2) {
+            std::copy(encounter_swap.begin() + begin, encounter_swap.begin() + end,
+                      encounter_list.begin() + begin);
+            continue;
+        }
+        std::fill(slots.begin(), slots.end(), 0);
+        for (size_t e = begin; e < end; ++e) {
+            slots[(encounter_swap[e].target & SLOT_MASK) + 1] += 1;
+        }
+        slots[0] = begin;
+        for (size_t slot = 1; slot < slots.size(); ++slot) {
+            slots[slot] += slots[slot - 1];
+        }
+        for (size_t e = begin; e < end; ++e) {
+            encounter_list[slots[encounter_swap[e].target & SLOT_MASK]++] = encounter_swap[e];
+        }
+    }
 }
@@ -0,0 +1,71 @@
+#include "random.h"
+
+#include <cstdint>
+#include <random>
+
+// Finalizer of SplitMix64, every input bit affects every output bit
+static uint64_t mix(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+Random::Random(unsigned int seed, RandomMode mode) : mode(mode), seed(seed), engine(seed) {}
+
+void Random::reseed(unsigned int seed) {
+    this->seed = seed;
+    epoch = 0;
+    engine.seed(seed);
+}
+
+void Random::restart() {
+    // NOTE: The stream simply continues, keys need a new epoch to stop repeating the last run
+    epoch += 1;
+}
+
+double Random::chance(int day, int cell, Purpose purpose, uint32_t index) {
+    if (mode == RandomMode::Sequential) {
+        std::uniform_real_distribution<double> dist(0.0, 1.0);
+        return dist(engine);
+    }
+    // Top 53 bits give every double in [0, 1) with a step of 2^-53
+    return (hash(day, cell, purpose, index) >> 11) * 0x1.0p-53;
+}
+
+int Random::pick(int count, int day, int cell, Purpose purpose, uint32_t index) {
+    if (mode == RandomMode::Sequential) {
+        std::uniform_int_distribution<> dist(0, count - 1);
+        return dist(engine);
+    }
+    // NOTE: Multiply-shift over the whole 64-bit draw, the top 64 bits of h * count. The relative
+    // bias of any result is below count / 2^64, under 2^-33 for any int count. The product is
+    // split in 32-bit halves as not every compiler has a 128-bit integer.
+    uint64_t h = hash(day, cell, purpose, index);
+    uint64_t n = static_cast<uint64_t>(count);
+    uint64_t low = ((h & 0xffffffffULL) * n) >> 32;
+    return static_cast<int>(((h >> 32) * n + low) >> 32);
+}
+
+RandomMode Random::get_mode() const {
+    return mode;
+}
+
+unsigned int Random::get_seed() const {
+    return seed;
+}
+
+uint64_t Random::get_epoch() const {
+    return epoch;
+}
+
+void Random::set_mode(RandomMode mode) {
+    this->mode = mode;
+}
+
+uint64_t Random::hash(int day, int cell, Purpose purpose, uint32_t index) const {
+    uint64_t h = mix(seed ^ (epoch << 32));
+    h = mix(h ^ static_cast<uint32_t>(day));
+    h = mix(h ^ static_cast<uint32_t>(cell));
+    return mix(h ^ (static_cast<uint64_t>(purpose) << 32 | index));
+}
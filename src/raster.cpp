@@ -0,0 +1,71 @@
+#include "raster.h"
+
+#include <cctype>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Read the next header token, skipping whitespace and "#" comments
+static int read_header_value(std::istream &file, const std::string &path) {
+    while (true) {
+        int c = file.peek();
+        if (c == '#') {
+            std::string comment;
+            std::getline(file, comment);
+        } else if (std::isspace(c)) {
+            file.get();
+        } else {
+            break;
+        }
+    }
+    int value = 0;
+    if (!(file >> value) || value < 0) {
+        throw std::invalid_argument("Malformed PGM header: " + path);
+    }
+    return value;
+}
+
+std::vector<int> read_pgm(const std::string &path, int &height, int &width) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Cannot open raster file: " + path);
+    }
+
+    // NOTE: Supports plain (P2) and binary (P5) graymaps, 8 or 16 bits per value
+    std::string magic;
+    file >> magic;
+    if (magic != "P2" && magic != "P5") {
+        throw std::invalid_argument("Raster must be a PGM (P2 or P5) file: " + path);
+    }
+    width = read_header_value(file, path);
+    height = read_header_value(file, path);
+    int max_value = read_header_value(file, path);
+    if (max_value <= 0 || max_value > 65535) {
+        throw std::invalid_argument("PGM max value must be between 1 and 65535: " + path);
+    }
+
+    std::vector<int> values(static_cast<size_t>(height) * width);
+    if (magic == "P2") {
+        for (int &value : values) {
+            if (!(file >> value)) {
+                throw std::invalid_argument("Truncated PGM data: " + path);
+            }
+        }
+        return values;
+    }
+
+    // Exactly one whitespace byte separates the header from binary data
+    file.get();
+    const int bytes = (max_value < 256) ? 1 : 2;
+    std::vector<unsigned char> buffer(values.size() * bytes);
+    if (!file.read(reinterpret_cast<char *>(buffer.data()),
+                   static_cast<std::streamsize>(buffer.size()))) {
+        throw std::invalid_argument("Truncated PGM data: " + path);
+    }
+    for (size_t k = 0; k < values.size(); ++k) {
+        // NOTE: 16-bit PGM values are big-endian
+        values[k] = (bytes == 1) ? buffer[k] : (buffer[2 * k] << 8) | buffer[2 * k + 1];
+    }
+    return values;
+}
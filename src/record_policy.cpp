@@ -0,0 +1,120 @@
+#include "record_policy.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+RecordPolicy RecordPolicy::full() {
+    return RecordPolicy();
+}
+
+RecordPolicy RecordPolicy::stats_only() {
+    RecordPolicy policy;
+    policy.frames = false;
+    return policy;
+}
+
+RecordPolicy RecordPolicy::every(int stride) {
+    RecordPolicy policy;
+    policy.stride = stride;
+    policy.validate();
+    return policy;
+}
+
+RecordPolicy RecordPolicy::on_days(const std::vector<int> &days) {
+    RecordPolicy policy;
+    policy.by_days = true;
+    policy.days = days;
+    std::sort(policy.days.begin(), policy.days.end());
+    policy.days.erase(std::unique(policy.days.begin(), policy.days.end()), policy.days.end());
+    policy.validate();
+    return policy;
+}
+
+bool RecordPolicy::records(int day) const {
+    if (!frames) return false;
+    // NOTE: An empty day list records nothing, it must not fall back to the stride
+    if (by_days) {
+        return std::binary_search(days.begin(), days.end(), day);
+    }
+    return day % stride == 0;
+}
+
+int RecordPolicy::count_frames(int days_in_simulation) const {
+    if (!frames) return 0;
+    if (by_days) {
+        return static_cast<int>(std::upper_bound(days.begin(), days.end(), days_in_simulation) -
+                                days.begin());
+    }
+    return days_in_simulation / stride + 1;
+}
+
+bool RecordPolicy::has_region() const {
+    return height >= 0 && width >= 0;
+}
+
+bool RecordPolicy::get_frames() const {
+    return frames;
+}
+
+int RecordPolicy::get_stride() const {
+    return stride;
+}
+
+const std::vector<int> &RecordPolicy::get_days() const {
+    return days;
+}
+
+int RecordPolicy::get_row() const {
+    return row;
+}
+
+int RecordPolicy::get_col() const {
+    return col;
+}
+
+int RecordPolicy::get_height() const {
+    return height;
+}
+
+int RecordPolicy::get_width() const {
+    return width;
+}
+
+bool RecordPolicy::get_metrics() const {
+    return metrics;
+}
+
+void RecordPolicy::set_region(int row, int col, int height, int width) {
+    if (height <= 0 || width <= 0) {
+        throw std::invalid_argument("Region height and width must be positive");
+    }
+    this->row = row;
+    this->col = col;
+    this->height = height;
+    this->width = width;
+    validate();
+}
+
+void RecordPolicy::clear_region() {
+    row = 0;
+    col = 0;
+    height = -1;
+    width = -1;
+}
+
+void RecordPolicy::set_metrics(bool metrics) {
+    this->metrics = metrics;
+}
+
+void RecordPolicy::validate() const {
+    if (stride <= 0) {
+        throw std::invalid_argument("Stride must be positive");
+    }
+    if (!days.empty() && days.front() < 0) {
+        throw std::invalid_argument("Recorded days must be non-negative");
+    }
+    if (row < 0 || col < 0) {
+        throw std::invalid_argument("Region origin must be non-negative");
+    }
+}
@@ -0,0 +1,188 @@
+#include "renderer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// NOTE: Same colors as examples/visualize.py
+static const std::vector<Renderer::Color> default_palette = {
+    {0xD3, 0xD3, 0xD3},  // Susceptible: Light Gray
+    {0xFF, 0x69, 0xB4},  // Incubated: Pink
+    {0xFF, 0x00, 0x00},  // Infected: Red
+    {0x22, 0x8B, 0x22},  // Recovered: Forest Green
+    {0x33, 0x33, 0x33},  // Dead: Light Black
+};
+
+Renderer::Renderer(int scale, int threads)
+    : palette(default_palette), scale(scale), threads(threads) {
+    validate();
+}
+
+Renderer::Renderer(const std::vector<Color> &palette, int scale, int threads)
+    : palette(palette), scale(scale), threads(threads) {
+    validate();
+}
+
+void Renderer::render(const int *data, int frames, int height, int width, uint8_t *out) const {
+    render_frames(data, frames, height, width, out);
+}
+
+void Renderer::render(const uint8_t *data, int frames, int height, int width,
+                      uint8_t *out) const {
+    render_frames(data, frames, height, width, out);
+}
+
+std::vector<uint8_t> Renderer::render(
+    const std::vector<std::vector<std::vector<int>>> &data) const {
+    if (data.empty() || data[0].empty()) return {};
+
+    int frames = static_cast<int>(data.size());
+    int height = static_cast<int>(data[0].size());
+    int width = static_cast<int>(data[0][0].size());
+
+    // Pack the nested vectors into one contiguous block first
+    std::vector<int> flat;
+    flat.reserve(static_cast<size_t>(frames) * height * width);
+    for (const auto &frame : data) {
+        for (const auto &row : frame) {
+            flat.insert(flat.end(), row.begin(), row.end());
+        }
+    }
+
+    std::vector<uint8_t> out(static_cast<size_t>(frames) * get_output_height(height) *
+                             get_output_width(width) * 3);
+    render_frames(flat.data(), frames, height, width, out.data());
+    return out;
+}
+
+int Renderer::get_output_height(int height) const {
+    return (height + scale - 1) / scale;
+}
+
+int Renderer::get_output_width(int width) const {
+    return (width + scale - 1) / scale;
+}
+
+const std::vector<Renderer::Color> &Renderer::get_palette() const {
+    return palette;
+}
+
+int Renderer::get_scale() const {
+    return scale;
+}
+
+int Renderer::get_threads() const {
+    return threads;
+}
+
+void Renderer::set_palette(const std::vector<Color> &palette) {
+    this->palette = palette;
+    validate();
+}
+
+void Renderer::set_scale(int scale) {
+    this->scale = scale;
+    validate();
+}
+
+void Renderer::set_threads(int threads) {
+    this->threads = threads;
+    validate();
+}
+
+void Renderer::validate() const {
+    if (palette.empty() || palette.size() > 256) {
+        throw std::invalid_argument("Palette must have between 1 and 256 colors");
+    }
+    if (scale <= 0) {
+        throw std::invalid_argument("Scale must be positive");
+    }
+    if (threads < 0) {
+        throw std::invalid_argument("Threads must be non-negative");
+    }
+}
+
+template <typename T>
+void Renderer::render_frames(const T *data, int frames, int height, int width,
+                             uint8_t *out) const {
+    if (frames < 0 || height < 0 || width < 0) {
+        throw std::invalid_argument("Frame dimensions must be non-negative");
+    }
+    if (frames == 0 || height == 0 || width == 0) return;
+
+    const size_t in_stride = static_cast<size_t>(height) * width;
+    const size_t out_stride =
+        static_cast<size_t>(get_output_height(height)) * get_output_width(width) * 3;
+
+    // Frames are independent, so workers simply pull the next unrendered one
+    int workers = (threads == 0) ? static_cast<int>(std::thread::hardware_concurrency()) : threads;
+    workers = std::max(1, std::min(workers, frames));
+
+    std::atomic<int> next(0);
+    auto work = [&]() {
+        for (int f = next++; f < frames; f = next++) {
+            render_frame(data + f * in_stride, height, width, out + f * out_stride);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (int t = 1; t < workers; ++t) {
+        pool.emplace_back(work);
+    }
+    work();
+    for (auto &thread : pool) {
+        thread.join();
+    }
+}
+
+template <typename T>
+void Renderer::render_frame(const T *frame, int height, int width, uint8_t *out) const {
+    const int colors = static_cast<int>(palette.size());
+    const Color unknown = {0, 0, 0};
+
+    // Fast path: one cell per pixel
+    if (scale == 1) {
+        const size_t cells = static_cast<size_t>(height) * width;
+        for (size_t c = 0; c < cells; ++c) {
+            int status = static_cast<int>(frame[c]);
+            const Color &color = (status >= 0 && status < colors) ? palette[status] : unknown;
+            out[3 * c + 0] = color[0];
+            out[3 * c + 1] = color[1];
+            out[3 * c + 2] = color[2];
+        }
+        return;
+    }
+
+    // Block-majority: each pixel takes the most frequent status of its block
+    // NOTE: Ties resolve to the lower status value, partial edge blocks vote with what they have
+    const int out_height = get_output_height(height);
+    const int out_width = get_output_width(width);
+    std::vector<int> votes(colors, 0);
+
+    for (int bi = 0; bi < out_height; ++bi) {
+        for (int bj = 0; bj < out_width; ++bj) {
+            std::fill(votes.begin(), votes.end(), 0);
+            int i_end = std::min(height, (bi + 1) * scale);
+            int j_end = std::min(width, (bj + 1) * scale);
+            for (int i = bi * scale; i < i_end; ++i) {
+                const T *row = frame + static_cast<size_t>(i) * width;
+                for (int j = bj * scale; j < j_end; ++j) {
+                    int status = static_cast<int>(row[j]);
+                    if (status >= 0 && status < colors) votes[status] += 1;
+                }
+            }
+
+            int winner = static_cast<int>(std::max_element(votes.begin(), votes.end()) -
+                                          votes.begin());
+            const Color &color = (votes[winner] > 0) ? palette[winner] : unknown;
+            uint8_t *pixel = out + 3 * (static_cast<size_t>(bi) * out_width + bj);
+            pixel[0] = color[0];
+            pixel[1] = color[1];
+            pixel[2] = color[2];
+        }
+    }
+}
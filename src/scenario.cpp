@@ -0,0 +1,342 @@
+#include "scenario.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "class_table.h"
+#include "disease.h"
+#include "layout.h"
+#include "model.h"
+#include "population.h"
+#include "random.h"
+#include "record_policy.h"
+#include "writer.h"
+
+static std::string trim(const std::string &text) {
+    size_t begin = text.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) return "";
+    size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(begin, end - begin + 1);
+}
+
+template <typename T>
+static T parse(const std::string &key, const std::string &value) {
+    std::istringstream stream(value);
+    T result;
+    if (!(stream >> result) || !(stream >> std::ws).eof()) {
+        throw std::invalid_argument("Invalid value for " + key + ": " + value);
+    }
+    return result;
+}
+
+template <typename T>
+static std::vector<T> parse_list(const std::string &key, const std::string &value) {
+    std::istringstream stream(value);
+    std::vector<T> result;
+    T item;
+    while (stream >> item) {
+        result.push_back(item);
+    }
+    if (!stream.eof()) {
+        throw std::invalid_argument("Invalid list for " + key + ": " + value);
+    }
+    return result;
+}
+
+// Parse a byte count with an optional binary suffix: K, M or G
+static size_t parse_bytes(const std::string &key, const std::string &value) {
+    std::istringstream stream(value);
+    double number = 0.0;
+    std::string suffix;
+    if (!(stream >> number) || number < 0.0) {
+        throw std::invalid_argument("Invalid value for " + key + ": " + value);
+    }
+    stream >> suffix;
+    double scale = 1.0;
+    if (suffix == "K") {
+        scale = 1024.0;
+    } else if (suffix == "M") {
+        scale = 1024.0 * 1024.0;
+    } else if (suffix == "G") {
+        scale = 1024.0 * 1024.0 * 1024.0;
+    } else if (!suffix.empty()) {
+        throw std::invalid_argument("Invalid value for " + key + ": " + value);
+    }
+    return static_cast<size_t>(number * scale);
+}
+
+Scenario Scenario::load(const std::string &path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("Cannot open scenario file: " + path);
+    }
+
+    Scenario scenario;
+    scenario.name = std::filesystem::path(path).stem().string();
+
+    std::string line;
+    std::string section = "";
+    int number = 0;
+    while (std::getline(file, line)) {
+        number += 1;
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) continue;
+
+        if (line.front() == '[' && line.back() == ']') {
+            section = trim(line.substr(1, line.size() - 2));
+            continue;
+        }
+
+        size_t equal = line.find('=');
+        if (equal == std::string::npos) {
+            throw std::invalid_argument(path + ":" + std::to_string(number) +
+                                        ": expected key = value");
+        }
+        try {
+            scenario.set(section, trim(line.substr(0, equal)), trim(line.substr(equal + 1)));
+        } catch (const std::invalid_argument &error) {
+            throw std::invalid_argument(path + ":" + std::to_string(number) + ": " +
+                                        error.what());
+        }
+    }
+
+    // NOTE: Output paths are relative to the scenario file, not the working directory
+    std::filesystem::path base = std::filesystem::path(path).parent_path();
+    if (!scenario.stats_path.empty()) {
+        scenario.stats_path = (base / scenario.stats_path).string();
+    }
+    if (!scenario.frames_path.empty()) {
+        scenario.frames_path = (base / scenario.frames_path).string();
+    }
+    for (std::string *relative : {&scenario.classes_path, &scenario.zones_path,
+                                  &scenario.zones_output}) {
+        if (!relative->empty()) *relative = (base / *relative).string();
+    }
+    return scenario;
+}
+
+std::unique_ptr<Model> Scenario::build() const {
+    auto disease = std::make_shared<Disease>(transmission_rate, fatality_rate,
+                                             days_in_incubation, days_with_symptoms, name);
+    auto population = std::make_shared<Population>(size, travel_radius, encounters,
+                                                   init_incubations, init_infections, disease,
+                                                   seed, name, random_mode, memory_cap);
+    population->set_layout(layout, tile);
+    population->set_batched(batched);
+    if (!classes_path.empty()) {
+        population->load_classes(classes_path, std::make_shared<ClassTable>(class_parameters));
+        // NOTE: Reseed so the initial cases get the durations of their own class
+        population->reset(true);
+    }
+    if (!zones_path.empty()) {
+        population->load_zones(zones_path);
+    }
+    for (const Disease &strain : strains) {
+        population->add_strain(std::make_shared<Disease>(strain), cross_immunity);
+    }
+    population->vaccinate(vaccinations);
+    population->seed_incubations(incubations);
+    for (size_t k = 0; k < strain_incubations.size(); ++k) {
+        population->seed_incubations(strain_incubations[k], static_cast<int>(k) + 1);
+    }
+
+    auto model = std::make_unique<Model>(days, population, name, policy, memory_cap,
+                                         stream ? frames_path : "");
+    model->set_verbose(false);
+    model->set_pipeline_depth(pipeline);
+    return model;
+}
+
+void Scenario::run() const {
+    // NOTE: Streamed frames are written while simulating, so directories must exist beforehand
+    for (const std::string &path : {stats_path, frames_path, zones_output}) {
+        std::filesystem::path parent = std::filesystem::path(path).parent_path();
+        if (!path.empty() && !parent.empty()) std::filesystem::create_directories(parent);
+    }
+    std::unique_ptr<Model> model = build();
+    model->simulate(days);
+
+    if (!stats_path.empty()) write_stats_csv(*model, stats_path);
+    if (!frames_path.empty() && !stream) write_frames(*model, frames_path);
+    if (!zones_output.empty()) write_zone_stats_csv(*model, zones_output);
+}
+
+std::string Scenario::get_name() const {
+    return name;
+}
+
+std::string Scenario::get_stats_path() const {
+    return stats_path;
+}
+
+std::string Scenario::get_frames_path() const {
+    return frames_path;
+}
+
+void Scenario::set(const std::string &section, const std::string &key, const std::string &value) {
+    const std::string id = section.empty() ? key : section + "." + key;
+
+    if (id == "name") {
+        name = value;
+    } else if (id == "disease.transmission_rate") {
+        transmission_rate = parse<double>(id, value);
+    } else if (id == "disease.fatality_rate") {
+        fatality_rate = parse<double>(id, value);
+    } else if (id == "disease.days_in_incubation") {
+        days_in_incubation = parse<int>(id, value);
+    } else if (id == "disease.days_with_symptoms") {
+        days_with_symptoms = parse<int>(id, value);
+    } else if (id == "population.size") {
+        size = parse<int>(id, value);
+    } else if (id == "population.travel_radius") {
+        travel_radius = parse<int>(id, value);
+    } else if (id == "population.encounters") {
+        encounters = parse<int>(id, value);
+    } else if (id == "population.init_incubations") {
+        init_incubations = parse<int>(id, value);
+    } else if (id == "population.init_infections") {
+        init_infections = parse<int>(id, value);
+    } else if (id == "population.seed") {
+        seed = parse<unsigned int>(id, value);
+    } else if (id == "population.layout") {
+        // One of: row-major, morton, tiled [k]
+        std::istringstream stream(value);
+        std::string mode;
+        stream >> mode;
+        std::string rest;
+        std::getline(stream, rest);
+        if (mode == "row-major") {
+            layout = Layout::RowMajor;
+        } else if (mode == "morton") {
+            layout = Layout::Morton;
+        } else if (mode == "tiled") {
+            layout = Layout::Tiled;
+            if (rest.find_first_not_of(" \t") != std::string::npos) tile = parse<int>(id, rest);
+        } else {
+            throw std::invalid_argument("Unknown layout: " + mode);
+        }
+    } else if (id == "population.random") {
+        if (value == "sequential") {
+            random_mode = RandomMode::Sequential;
+        } else if (value == "keyed") {
+            random_mode = RandomMode::Keyed;
+        } else {
+            throw std::invalid_argument("population.random must be sequential or keyed");
+        }
+    } else if (id == "population.spread") {
+        if (value != "per-person" && value != "batched") {
+            throw std::invalid_argument("population.spread must be per-person or batched");
+        }
+        batched = value == "batched";
+    } else if (id == "population.zones") {
+        zones_path = value;
+    } else if (id == "model.days") {
+        days = parse<int>(id, value);
+    } else if (id == "model.record") {
+        // One of: full, stats, every <k>, days <d>...
+        std::istringstream stream(value);
+        std::string mode;
+        stream >> mode;
+        std::string rest;
+        std::getline(stream, rest);
+        RecordPolicy next;
+        if (mode == "full") {
+            next = RecordPolicy::full();
+        } else if (mode == "stats") {
+            next = RecordPolicy::stats_only();
+        } else if (mode == "every") {
+            next = RecordPolicy::every(parse<int>(id, rest));
+        } else if (mode == "days") {
+            next = RecordPolicy::on_days(parse_list<int>(id, rest));
+        } else {
+            throw std::invalid_argument("Unknown record mode: " + mode);
+        }
+        next.set_metrics(policy.get_metrics());
+        if (policy.has_region()) {
+            next.set_region(policy.get_row(), policy.get_col(), policy.get_height(),
+                            policy.get_width());
+        }
+        policy = next;
+    } else if (id == "model.memory_cap") {
+        memory_cap = parse_bytes(id, value);
+    } else if (id == "model.pipeline") {
+        pipeline = parse<int>(id, value);
+        if (pipeline < 0) {
+            throw std::invalid_argument("model.pipeline must be non-negative");
+        }
+    } else if (id == "model.metrics") {
+        if (value != "true" && value != "false") {
+            throw std::invalid_argument("model.metrics must be true or false");
+        }
+        policy.set_metrics(value == "true");
+    } else if (id == "model.region") {
+        std::vector<int> region = parse_list<int>(id, value);
+        if (region.size() != 4) {
+            throw std::invalid_argument("Region must be: row col height width");
+        }
+        policy.set_region(region[0], region[1], region[2], region[3]);
+    } else if (id == "seeds.incubations") {
+        incubations = parse_list<int>(id, value);
+    } else if (id == "seeds.vaccinations") {
+        vaccinations = parse_list<int>(id, value);
+    } else if (id == "classes.raster") {
+        classes_path = value;
+    } else if (id == "classes.table") {
+        // Classes separated by ";", each: susceptibility fatality_rate incubation symptoms
+        class_parameters.clear();
+        std::istringstream stream(value);
+        std::string entry;
+        while (std::getline(stream, entry, ';')) {
+            std::vector<double> fields = parse_list<double>(id, entry);
+            if (fields.size() != 4) {
+                throw std::invalid_argument(
+                    "Class must be: susceptibility fatality_rate incubation symptoms");
+            }
+            class_parameters.push_back({fields[0], fields[1], static_cast<int>(fields[2]),
+                                        static_cast<int>(fields[3])});
+        }
+    } else if (id == "strains.table") {
+        // Strains after the disease separated by ";", each: rate fatality_rate incubation symptoms
+        strains.clear();
+        std::istringstream stream(value);
+        std::string entry;
+        while (std::getline(stream, entry, ';')) {
+            std::vector<double> fields = parse_list<double>(id, entry);
+            if (fields.size() != 4) {
+                throw std::invalid_argument(
+                    "Strain must be: transmission_rate fatality_rate incubation symptoms");
+            }
+            strains.emplace_back(fields[0], fields[1], static_cast<int>(fields[2]),
+                                 static_cast<int>(fields[3]));
+        }
+    } else if (id == "strains.cross_immunity") {
+        cross_immunity = parse<double>(id, value);
+    } else if (id == "strains.incubations") {
+        // One cell list per strain after the disease, separated by ";"
+        strain_incubations.clear();
+        std::istringstream stream(value);
+        std::string entry;
+        while (std::getline(stream, entry, ';')) {
+            strain_incubations.push_back(parse_list<int>(id, entry));
+        }
+    } else if (id == "output.stats") {
+        stats_path = value;
+    } else if (id == "output.frames") {
+        frames_path = value;
+    } else if (id == "output.stream") {
+        if (value != "true" && value != "false") {
+            throw std::invalid_argument("output.stream must be true or false");
+        }
+        stream = value == "true";
+    } else if (id == "output.zones") {
+        zones_output = value;
+    } else {
+        throw std::invalid_argument("Unknown key: " + id);
+    }
+}
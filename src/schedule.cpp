@@ -0,0 +1,102 @@
+#include "schedule.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "disease.h"
+#include "person.h"
+#include "population.h"
+
+void Schedule::add_change(int day, Parameter parameter, double value) {
+    if (day < 1) {
+        throw std::invalid_argument("Scheduled day must be positive");
+    }
+    validate(parameter, value);
+    // NOTE: Insert after existing changes of the same day so they apply in the order given
+    auto position = std::upper_bound(changes.begin(), changes.end(), day,
+                                     [](int d, const Change &change) { return d < change.day; });
+    changes.insert(position, Change{day, parameter, value});
+}
+
+void Schedule::add_rule(Status status, int threshold, Parameter parameter, double value,
+                        bool above, bool once) {
+    if (threshold < 0) {
+        throw std::invalid_argument("Rule threshold must be non-negative");
+    }
+    validate(parameter, value);
+    rules.push_back(Rule{status, threshold, above, parameter, value, once});
+}
+
+void Schedule::apply(int day, Population &population, std::vector<bool> &fired) const {
+    // Day-indexed changes first
+    auto it = std::lower_bound(changes.begin(), changes.end(), day,
+                               [](const Change &change, int d) { return change.day < d; });
+    for (; it != changes.end() && it->day == day; ++it) {
+        set(population, it->parameter, it->value);
+    }
+
+    // Then rules, checked against the counts the day starts with
+    // NOTE: Rules added since the caller's last apply start out unfired
+    if (fired.size() < rules.size()) fired.resize(rules.size(), false);
+    const std::vector<int> &status_count = population.get_status_count();
+    for (size_t i = 0; i < rules.size(); ++i) {
+        const Rule &rule = rules[i];
+        if (rule.once && fired[i]) continue;
+
+        int count = status_count[static_cast<int>(rule.status)];
+        bool triggered = rule.above ? count >= rule.threshold : count <= rule.threshold;
+        if (!triggered) continue;
+
+        set(population, rule.parameter, rule.value);
+        fired[i] = true;
+    }
+}
+
+void Schedule::clear() {
+    changes.clear();
+    rules.clear();
+}
+
+int Schedule::get_change_count() const {
+    return static_cast<int>(changes.size());
+}
+
+int Schedule::get_rule_count() const {
+    return static_cast<int>(rules.size());
+}
+
+void Schedule::validate(Parameter parameter, double value) {
+    switch (parameter) {
+        case Parameter::Encounters:
+        case Parameter::TravelRadius:
+            if (value < 0) {
+                throw std::invalid_argument("Encounters and travel radius must be non-negative");
+            }
+            break;
+        case Parameter::TransmissionRate:
+        case Parameter::FatalityRate:
+            if (value < 0 || value > 1) {
+                throw std::invalid_argument("Rates must be between 0 and 1");
+            }
+            break;
+    }
+}
+
+void Schedule::set(Population &population, Parameter parameter, double value) {
+    switch (parameter) {
+        case Parameter::Encounters:
+            population.set_encounters(static_cast<int>(std::lround(value)));
+            break;
+        case Parameter::TravelRadius:
+            population.set_travel_radius(static_cast<int>(std::lround(value)));
+            break;
+        case Parameter::TransmissionRate:
+            population.set_transmission_rate(value);
+            break;
+        case Parameter::FatalityRate:
+            population.set_fatality_rate(value);
+            break;
+    }
+}
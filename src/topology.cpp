@@ -0,0 +1,237 @@
+#include "topology.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "class_table.h"
+#include "layout.h"
+#include "memory.h"
+
+Topology::Topology(int size, int travel_radius, Layout layout, int tile, bool neighbor_cache)
+    : size(size), travel_radius(travel_radius), layout(layout), tile(tile) {
+    validate();
+    compute_order();
+    if (neighbor_cache) compute_neighbors();
+}
+
+std::shared_ptr<const Topology> Topology::with_travel_radius(int radius) const {
+    if (radius < 0) {
+        throw std::invalid_argument("Travel radius must be non-negative");
+    }
+    auto topology = std::make_shared<Topology>(*this);
+    topology->travel_radius = radius;
+    // NOTE: Neighbors were precomputed for the old radius
+    if (neighbors && radius != travel_radius) topology->compute_neighbors();
+    return topology;
+}
+
+std::shared_ptr<const Topology> Topology::with_layout(Layout layout, int tile) const {
+    if (tile <= 0) {
+        throw std::invalid_argument("Tile size must be positive");
+    }
+    auto topology = std::make_shared<Topology>(*this);
+    if (layout == this->layout && tile == this->tile) return topology;
+    topology->layout = layout;
+    topology->tile = tile;
+    topology->compute_order();
+    if (neighbors) topology->compute_neighbors();
+    return topology;
+}
+
+std::shared_ptr<const Topology> Topology::with_neighbor_cache(bool enabled) const {
+    auto topology = std::make_shared<Topology>(*this);
+    if (!enabled) {
+        topology->neighbors.reset();
+    } else if (!neighbors) {
+        topology->compute_neighbors();
+    }
+    return topology;
+}
+
+std::shared_ptr<const Topology> Topology::with_classes(const std::vector<uint8_t> &classes,
+                                                       std::shared_ptr<ClassTable> table) const {
+    if (table.get() == nullptr) {
+        throw std::invalid_argument("Class table shared pointer cannot be null");
+    }
+    if (classes.size() != static_cast<size_t>(size) * size) {
+        throw std::invalid_argument("Classes must have size x size elements");
+    }
+    for (uint8_t index : classes) {
+        if (index >= table->get_size()) {
+            throw std::invalid_argument("Class index out of range of the class table");
+        }
+    }
+    auto topology = std::make_shared<Topology>(*this);
+    topology->classes = classes;
+    topology->class_table = std::move(table);
+    return topology;
+}
+
+std::shared_ptr<const Topology> Topology::without_classes() const {
+    auto topology = std::make_shared<Topology>(*this);
+    topology->classes.clear();
+    topology->classes.shrink_to_fit();
+    topology->class_table.reset();
+    return topology;
+}
+
+std::shared_ptr<const Topology> Topology::with_zones(const std::vector<int> &zones) const {
+    if (zones.size() != static_cast<size_t>(size) * size) {
+        throw std::invalid_argument("Zones must have size x size elements");
+    }
+    int count = 0;
+    for (int zone : zones) {
+        if (zone < 0) {
+            throw std::invalid_argument("Zone labels must be non-negative");
+        }
+        count = std::max(count, zone + 1);
+    }
+    auto topology = std::make_shared<Topology>(*this);
+    topology->zones = zones;
+    topology->zone_count = count;
+    return topology;
+}
+
+std::shared_ptr<const Topology> Topology::without_zones() const {
+    auto topology = std::make_shared<Topology>(*this);
+    topology->zones.clear();
+    topology->zones.shrink_to_fit();
+    topology->zone_count = 0;
+    return topology;
+}
+
+int Topology::get_size() const {
+    return size;
+}
+
+int Topology::get_travel_radius() const {
+    return travel_radius;
+}
+
+Layout Topology::get_layout() const {
+    return layout;
+}
+
+int Topology::get_tile() const {
+    return tile;
+}
+
+bool Topology::get_neighbor_cache() const {
+    return neighbors != nullptr;
+}
+
+const std::vector<int> &Topology::get_order() const {
+    return order;
+}
+
+const std::vector<int> &Topology::get_slots() const {
+    return slots;
+}
+
+int Topology::get_neighbor_count(int slot) const {
+    return static_cast<int>(neighbors->offsets[slot + 1] - neighbors->offsets[slot]);
+}
+
+const uint32_t *Topology::get_neighbors(int slot) const {
+    return neighbors->slots.data() + neighbors->offsets[slot];
+}
+
+const std::vector<uint8_t> &Topology::get_classes() const {
+    return classes;
+}
+
+std::shared_ptr<ClassTable> Topology::get_class_table() const {
+    return class_table;
+}
+
+const ClassParameters *Topology::get_class_parameters(int cell) const {
+    if (classes.empty()) return nullptr;
+    return &class_table->get(classes[cell]);
+}
+
+const std::vector<int> &Topology::get_zones() const {
+    return zones;
+}
+
+int Topology::get_zone_count() const {
+    return zone_count;
+}
+
+MemoryUsage Topology::get_memory() const {
+    MemoryUsage usage;
+    if (neighbors) {
+        usage.neighbors = neighbors->offsets.capacity() * sizeof(size_t) +
+                          neighbors->slots.capacity() * sizeof(uint32_t);
+    }
+    usage.tables = (order.capacity() + slots.capacity() + zones.capacity()) * sizeof(int) +
+                   classes.capacity();
+    return usage;
+}
+
+MemoryUsage Topology::estimate_memory(int size, int travel_radius, bool neighbor_cache) {
+    if (size <= 0 || travel_radius < 0) {
+        throw std::invalid_argument("Size must be positive and travel radius non-negative");
+    }
+    size_t cells = static_cast<size_t>(size) * size;
+
+    MemoryUsage usage;
+    usage.tables = 2 * cells * sizeof(int);
+    if (neighbor_cache) {
+        // Window rows summed over all rows, the same for columns, minus each cell itself
+        size_t span = 0;
+        for (int i = 0; i < size; ++i) {
+            span += std::min(size - 1, i + travel_radius) - std::max(0, i - travel_radius) + 1;
+        }
+        usage.neighbors = (cells + 1) * sizeof(size_t) + (span * span - cells) * sizeof(uint32_t);
+    }
+    return usage;
+}
+
+void Topology::validate() const {
+    if (size <= 0) {
+        throw std::invalid_argument("Size must be positive");
+    }
+    if (travel_radius < 0) {
+        throw std::invalid_argument("Travel radius must be non-negative");
+    }
+    if (tile <= 0) {
+        throw std::invalid_argument("Tile size must be positive");
+    }
+}
+
+void Topology::compute_order() {
+    order = order_cells(size, layout, tile);
+    slots.resize(order.size());
+    for (size_t slot = 0; slot < order.size(); ++slot) {
+        slots[order[slot]] = static_cast<int>(slot);
+    }
+}
+
+void Topology::compute_neighbors() {
+    // NOTE: Rows are built in storage order, but each row keeps the row-major neighbor order
+    // so sampling picks the same people whatever the layout
+    MemoryUsage usage = estimate_memory(size, travel_radius, true);
+    auto table = std::make_shared<NeighborTable>();
+    table->offsets.reserve(order.size() + 1);
+    table->slots.reserve((usage.neighbors - (order.size() + 1) * sizeof(size_t)) /
+                         sizeof(uint32_t));
+    table->offsets.push_back(0);
+    for (int cell : order) {
+        int i = cell / size, j = cell % size;
+        for (int di = -travel_radius; di <= travel_radius; ++di) {
+            for (int dj = -travel_radius; dj <= travel_radius; ++dj) {
+                int ni = i + di;
+                int nj = j + dj;
+                if (ni >= 0 && ni < size && nj >= 0 && nj < size && !(di == 0 && dj == 0)) {
+                    table->slots.push_back(static_cast<uint32_t>(slots[ni * size + nj]));
+                }
+            }
+        }
+        table->offsets.push_back(table->slots.size());
+    }
+    neighbors = std::move(table);
+}
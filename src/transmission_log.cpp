@@ -0,0 +1,56 @@
+#include "transmission_log.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+void TransmissionLog::record(uint32_t infector, uint32_t infectee, uint32_t day) {
+    size_t offset = size % CHUNK_SIZE;
+    if (offset == 0 && size / CHUNK_SIZE == chunks.size()) {
+        // NOTE: One uninitialized allocation per chunk, the columns sit back to back inside it
+        chunks.push_back(std::unique_ptr<uint32_t[]>(new uint32_t[3 * CHUNK_SIZE]));
+    }
+    uint32_t *chunk = chunks[size / CHUNK_SIZE].get();
+    chunk[offset] = infector;
+    chunk[CHUNK_SIZE + offset] = infectee;
+    chunk[2 * CHUNK_SIZE + offset] = day;
+    size += 1;
+}
+
+void TransmissionLog::clear() {
+    chunks.clear();
+    size = 0;
+}
+
+size_t TransmissionLog::get_size() const {
+    return size;
+}
+
+int TransmissionLog::get_chunk_count() const {
+    return static_cast<int>((size + CHUNK_SIZE - 1) / CHUNK_SIZE);
+}
+
+size_t TransmissionLog::get_chunk_size(int chunk) const {
+    if (chunk < 0 || chunk >= get_chunk_count()) {
+        throw std::out_of_range("Chunk index out of range");
+    }
+    size_t begin = static_cast<size_t>(chunk) * CHUNK_SIZE;
+    return std::min(CHUNK_SIZE, size - begin);
+}
+
+const uint32_t *TransmissionLog::get_infectors(int chunk) const {
+    get_chunk_size(chunk);
+    return chunks[chunk].get();
+}
+
+const uint32_t *TransmissionLog::get_infectees(int chunk) const {
+    get_chunk_size(chunk);
+    return chunks[chunk].get() + CHUNK_SIZE;
+}
+
+const uint32_t *TransmissionLog::get_days(int chunk) const {
+    get_chunk_size(chunk);
+    return chunks[chunk].get() + 2 * CHUNK_SIZE;
+}
@@ -0,0 +1,82 @@
+#include "writer.h"
+
+#include <cstddef>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "frame_stream.h"
+#include "model.h"
+
+void write_stats_csv(const Model &model, const std::string &path) {
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error("Cannot open stats file: " + path);
+    }
+
+    // NOTE: Strains and spatial metrics become extra columns when the model has them
+    const auto &stats = model.get_stats();
+    const auto &metrics = model.get_metrics();
+    file << "day,susceptible,incubated,infected,recovered,dead";
+    size_t strains = stats.empty() ? 0 : (stats[0].size() - 5) / 3;
+    for (size_t strain = 0; strain < strains; ++strain) {
+        file << ",strain" << strain << "_incubated,strain" << strain << "_infected,strain" << strain
+             << "_infections";
+    }
+    if (!metrics.empty()) file << ",front,clusters,new_infections,new_per_infector";
+    file << '\n';
+
+    for (size_t day = 0; day < stats.size(); ++day) {
+        file << day;
+        for (int count : stats[day]) {
+            file << ',' << count;
+        }
+        if (day < metrics.size()) {
+            for (double value : metrics[day]) {
+                file << ',' << value;
+            }
+        }
+        file << '\n';
+    }
+
+    if (!file) {
+        throw std::runtime_error("Failed writing stats file: " + path);
+    }
+}
+
+void write_zone_stats_csv(const Model &model, const std::string &path) {
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error("Cannot open zone stats file: " + path);
+    }
+
+    file << "day,zone,susceptible,incubated,infected,recovered,dead\n";
+    const auto &zone_stats = model.get_zone_stats();
+    for (size_t day = 0; day < zone_stats.size(); ++day) {
+        const auto &counts = zone_stats[day];
+        for (size_t zone = 0; zone < counts.size() / 5; ++zone) {
+            file << day << ',' << zone;
+            for (size_t s = 0; s < 5; ++s) {
+                file << ',' << counts[zone * 5 + s];
+            }
+            file << '\n';
+        }
+    }
+
+    if (!file) {
+        throw std::runtime_error("Failed writing zone stats file: " + path);
+    }
+}
+
+void write_frames(const Model &model, const std::string &path) {
+    // NOTE: The model already stores one byte per cell in the order of the file
+    const auto &days = model.get_frame_days();
+    FrameStream stream(path, model.get_frame_height(), model.get_frame_width(),
+                       static_cast<int>(days.size()));
+    size_t frame_size = static_cast<size_t>(model.get_frame_height()) * model.get_frame_width();
+    for (size_t i = 0; i < days.size(); ++i) {
+        stream.write(days[i], model.get_frames().data() + i * frame_size);
+    }
+    stream.flush();
+}
@@ -0,0 +1,41 @@
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "check.h"
+#include "disease.h"
+#include "person.h"
+#include "population.h"
+
+// With keyed draws and one strain, the batched pass infects the same people as the per-person one
+std::vector<std::vector<int>> run(bool batched,
+                                  std::vector<std::vector<std::pair<int, int>>> *infections) {
+    auto disease = std::make_shared<Disease>(0.7, 0.05, 3, 5, "flu");
+    Population population(80, 3, 6, 12, 4, disease, 21, "city", RandomMode::Keyed);
+    population.isolate({3240, 3241, 3242}, 20);
+    population.set_batched(batched);
+
+    std::vector<std::vector<int>> counts{population.get_status_count()};
+    for (int day = 0; day < 60; ++day) {
+        population.update();
+        counts.push_back(population.get_status_count());
+        std::vector<std::pair<int, int>> positions;
+        for (const Person *person : population.get_new_infections()) {
+            positions.push_back(person->get_position());
+        }
+        infections->push_back(positions);
+    }
+    return counts;
+}
+
+int main() {
+    std::vector<std::vector<std::pair<int, int>>> per_person_infections;
+    std::vector<std::vector<std::pair<int, int>>> batched_infections;
+    std::vector<std::vector<int>> per_person = run(false, &per_person_infections);
+    std::vector<std::vector<int>> batched = run(true, &batched_infections);
+    CHECK(per_person == batched);
+    CHECK(per_person.back()[static_cast<int>(Status::Recovered)] > 100);
+
+    CHECK(per_person_infections == batched_infections);
+    return 0;
+}
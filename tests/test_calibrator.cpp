@@ -0,0 +1,63 @@
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "calibrator.h"
+#include "check.h"
+#include "disease.h"
+#include "person.h"
+#include "population.h"
+
+bool same(const CalibrationSample &a, const CalibrationSample &b) {
+    return a.transmission_rate == b.transmission_rate && a.fatality_rate == b.fatality_rate &&
+           a.days_in_incubation == b.days_in_incubation &&
+           a.days_with_symptoms == b.days_with_symptoms && a.distance == b.distance;
+}
+
+// Early rejection accepts exactly the candidates whose whole trajectory is within tolerance
+int main() {
+    auto disease = std::make_shared<Disease>(0.5, 0.02, 3, 6, "flu");
+    Population population(30, 2, 4, 5, 1, disease, 3);
+    std::vector<int> observed{population.get_status_count()[static_cast<int>(Status::Infected)]};
+    for (int day = 0; day < 40; ++day) {
+        population.update();
+        observed.push_back(population.get_status_count()[static_cast<int>(Status::Infected)]);
+    }
+
+    // Without a tolerance every candidate runs to the end and reports its full distance
+    const int candidates = 40;
+    Calibrator calibrator(observed, std::numeric_limits<double>::max(), 30, 2, 4, 5, 1,
+                          Status::Infected, 17, 1);
+    calibrator.set_days_in_incubation_prior(2, 5);
+    calibrator.set_days_with_symptoms_prior(4, 8);
+    std::vector<CalibrationSample> full = calibrator.run(candidates);
+    CHECK(static_cast<int>(full.size()) == candidates);
+    CHECK(calibrator.get_simulated_days() == 40LL * candidates);
+
+    std::vector<double> distances;
+    for (const auto &sample : full) distances.push_back(sample.distance);
+    std::sort(distances.begin(), distances.end());
+    double tolerance = distances[candidates / 4];
+    CHECK(distances.front() < tolerance && tolerance < distances.back());
+
+    calibrator.set_tolerance(tolerance);
+    std::vector<CalibrationSample> accepted = calibrator.run(candidates);
+    std::vector<CalibrationSample> expected;
+    for (const auto &sample : full) {
+        if (sample.distance <= tolerance) expected.push_back(sample);
+    }
+    CHECK(accepted.size() == expected.size());
+    for (size_t k = 0; k < accepted.size(); ++k) CHECK(same(accepted[k], expected[k]));
+    CHECK(calibrator.get_rejected() == candidates - static_cast<int>(accepted.size()));
+    CHECK(calibrator.get_simulated_days() < 40LL * candidates);
+
+    // The thread count changes neither the samples nor the work done
+    long long simulated_days = calibrator.get_simulated_days();
+    calibrator.set_threads(4);
+    std::vector<CalibrationSample> threaded = calibrator.run(candidates);
+    CHECK(threaded.size() == accepted.size());
+    for (size_t k = 0; k < threaded.size(); ++k) CHECK(same(threaded[k], accepted[k]));
+    CHECK(calibrator.get_simulated_days() == simulated_days);
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "check.h"
+#include "disease.h"
+#include "frame_pipeline.h"
+#include "frame_stream.h"
+#include "model.h"
+#include "population.h"
+#include "record_policy.h"
+
+namespace {
+
+// Whether the call throws the sink failure
+template <typename Call>
+bool fails(Call call) {
+    try {
+        call();
+    } catch (const std::runtime_error &) {
+        return true;
+    }
+    return false;
+}
+
+struct FrameFile {
+    uint32_t version = 0, count = 0, height = 0, width = 0, capacity = 0;
+    std::vector<int32_t> days;
+    std::vector<uint8_t> frames;
+};
+
+FrameFile read_frames(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    std::vector<char> bytes((std::istreambuf_iterator<char>(file)),
+                            std::istreambuf_iterator<char>());
+    CHECK(bytes.size() >= sizeof(FRAMES_MAGIC) + 20);
+    CHECK(std::memcmp(bytes.data(), FRAMES_MAGIC, sizeof(FRAMES_MAGIC)) == 0);
+
+    FrameFile result;
+    uint32_t header[5];
+    std::memcpy(header, bytes.data() + sizeof(FRAMES_MAGIC), sizeof(header));
+    result.version = header[0];
+    result.count = header[1];
+    result.height = header[2];
+    result.width = header[3];
+    result.capacity = header[4];
+    size_t table = sizeof(FRAMES_MAGIC) + sizeof(header);
+    size_t frames = table + result.capacity * sizeof(int32_t);
+    size_t frame_size = static_cast<size_t>(result.height) * result.width;
+    CHECK(bytes.size() == frames + result.count * frame_size);
+    result.days.resize(result.count);
+    std::memcpy(result.days.data(), bytes.data() + table, result.count * sizeof(int32_t));
+    result.frames.assign(bytes.begin() + frames, bytes.end());
+    return result;
+}
+
+}  // namespace
+
+// A failed pipeline stays failed, and streamed frame files match the frames kept in memory
+int main() {
+    int calls = 0;
+    FramePipeline pipeline(4, 2, [&calls](int day, const uint8_t *) {
+        calls += 1;
+        if (day == 1) throw std::runtime_error("sink failed");
+    });
+    for (int day = 0; day < 2; ++day) {
+        pipeline.acquire();
+        pipeline.submit(day);
+    }
+    CHECK(fails([&] { pipeline.flush(); }));
+    CHECK(fails([&] { pipeline.acquire(); }));
+    CHECK(fails([&] { pipeline.submit(2); }));
+    CHECK(fails([&] { pipeline.flush(); }));
+    CHECK(calls == 2);
+
+    const std::string path = "test_frames.bin";
+    auto disease = std::make_shared<Disease>(0.6, 0.02, 4, 6, "flu");
+    auto streamed_population = std::make_shared<Population>(24, 1, 3, 2, 1, disease, 5);
+    auto kept_population = std::make_shared<Population>(24, 1, 3, 2, 1, disease, 5);
+    Model streamed(30, streamed_population, "streamed", RecordPolicy::every(3), 0, path);
+    Model kept(30, kept_population, "kept", RecordPolicy::every(3));
+    streamed.set_verbose(false);
+    kept.set_verbose(false);
+    streamed.set_pipeline_depth(2);
+
+    // A partial run leaves the rest of the day table reserved
+    streamed.simulate(10);
+    kept.simulate(10);
+    FrameFile file = read_frames(path);
+    CHECK(file.version == FRAMES_VERSION);
+    CHECK(file.count == 4 && file.capacity == 11);
+    CHECK(file.height == 24 && file.width == 24);
+    CHECK(std::vector<int>(file.days.begin(), file.days.end()) == kept.get_frame_days());
+    CHECK(file.frames == kept.get_frames());
+
+    streamed.simulate(20);
+    kept.simulate(20);
+    file = read_frames(path);
+    CHECK(file.count == 11 && file.capacity == 11);
+    CHECK(std::vector<int>(file.days.begin(), file.days.end()) == kept.get_frame_days());
+    CHECK(file.frames == kept.get_frames());
+
+    // A rerun rewrites the file from the start
+    streamed.reset(true);
+    CHECK(streamed.get_pipeline_depth() == 2);
+    file = read_frames(path);
+    CHECK(file.count == 1 && file.days[0] == 0);
+    std::remove(path.c_str());
+    return 0;
+}
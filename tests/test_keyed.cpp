@@ -0,0 +1,91 @@
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "check.h"
+#include "disease.h"
+#include "layout.h"
+#include "model.h"
+#include "person.h"
+#include "population.h"
+#include "random.h"
+#include "record_policy.h"
+#include "schedule.h"
+
+// Per-day status counts of a keyed population stored and updated the given way
+std::vector<std::vector<int>> run(Layout layout, bool batched) {
+    auto disease = std::make_shared<Disease>(0.7, 0.05, 3, 5, "flu");
+    Population population(72, 3, 6, 12, 4, disease, 9, "city", RandomMode::Keyed);
+    population.set_layout(layout, 8);
+    population.set_batched(batched);
+
+    std::vector<std::vector<int>> counts{population.get_status_count()};
+    for (int day = 0; day < 50; ++day) {
+        population.update();
+        counts.push_back(population.get_status_count());
+    }
+    return counts;
+}
+
+// A keyed draw depends on (seed, epoch, day, cell, purpose, index) only
+int main() {
+    Random forward(7, RandomMode::Keyed);
+    Random backward(7, RandomMode::Keyed);
+    std::vector<int> picks;
+    for (int cell = 0; cell < 100; ++cell) {
+        picks.push_back(forward.pick(1000, 3, cell, Purpose::Encounter, 2));
+    }
+    for (int cell = 99; cell >= 0; --cell) {
+        CHECK(backward.pick(1000, 3, cell, Purpose::Encounter, 2) == picks[cell]);
+        CHECK(backward.chance(3, cell, Purpose::Transmission, 0) ==
+              forward.chance(3, cell, Purpose::Transmission, 0));
+    }
+
+    // A restart moves to a new epoch and reseeding goes back to the first
+    backward.restart();
+    int same = 0;
+    for (int cell = 0; cell < 100; ++cell) {
+        same += backward.pick(1000, 3, cell, Purpose::Encounter, 2) == picks[cell];
+    }
+    CHECK(same < 5);
+    backward.reseed(7);
+    CHECK(backward.pick(1000, 3, 0, Purpose::Encounter, 2) == picks[0]);
+
+    // Picks stay in range and spread evenly
+    std::vector<int> histogram(6, 0);
+    for (uint32_t index = 0; index < 60000; ++index) {
+        int value = forward.pick(6, 1, 0, Purpose::Encounter, index);
+        CHECK(value >= 0 && value < 6);
+        histogram[value] += 1;
+    }
+    for (int count : histogram) CHECK(count > 9500 && count < 10500);
+
+    // Neither the memory layout nor batching changes the outcome
+    std::vector<std::vector<int>> expected = run(Layout::RowMajor, false);
+    CHECK(expected.back()[static_cast<int>(Status::Recovered)] > 100);
+    for (Layout layout : {Layout::RowMajor, Layout::Morton, Layout::Tiled}) {
+        for (bool batched : {false, true}) {
+            CHECK(run(layout, batched) == expected);
+        }
+    }
+
+    // Paired arms share every draw, so they match until the intervention changes something
+    auto disease = std::make_shared<Disease>(0.6, 0.02, 4, 6, "flu");
+    auto baseline_population = std::make_shared<Population>(100, 2, 5, 4, 1, disease, 11,
+                                                            "city", RandomMode::Keyed);
+    auto intervention_population = std::make_shared<Population>(100, 2, 5, 4, 1, disease, 11,
+                                                                "city", RandomMode::Keyed);
+    Model baseline(60, baseline_population, "baseline", RecordPolicy::stats_only());
+    Model intervention(60, intervention_population, "intervention", RecordPolicy::stats_only());
+    baseline.set_verbose(false);
+    intervention.set_verbose(false);
+    auto schedule = std::make_shared<Schedule>();
+    schedule->add_change(25, Parameter::Encounters, 1);
+    simulate_paired(baseline, intervention, 60, nullptr, schedule);
+
+    const auto &baseline_stats = baseline.get_stats();
+    const auto &intervention_stats = intervention.get_stats();
+    for (int day = 0; day < 25; ++day) CHECK(baseline_stats[day] == intervention_stats[day]);
+    CHECK(baseline_stats.back() != intervention_stats.back());
+    return 0;
+}
@@ -0,0 +1,56 @@
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include "check.h"
+#include "disease.h"
+#include "layout.h"
+#include "person.h"
+#include "population.h"
+
+// Per-day status counts, optionally switching to another layout halfway through
+std::vector<std::vector<int>> run(Layout layout, int tile, Layout later) {
+    auto disease = std::make_shared<Disease>(0.7, 0.05, 3, 5, "flu");
+    Population population(70, 3, 6, 12, 4, disease, 13);
+    population.set_layout(layout, tile);
+
+    std::vector<std::vector<int>> counts{population.get_status_count()};
+    for (int day = 0; day < 50; ++day) {
+        if (day == 25) population.set_layout(later, tile);
+        population.update();
+        counts.push_back(population.get_status_count());
+    }
+    return counts;
+}
+
+// Every layout stores each cell exactly once and gives the same results for a given seed
+int main() {
+    std::vector<int> row_major(13 * 13);
+    std::iota(row_major.begin(), row_major.end(), 0);
+    for (Layout layout : {Layout::RowMajor, Layout::Morton, Layout::Tiled}) {
+        std::vector<int> order = order_cells(13, layout, 4);
+        std::sort(order.begin(), order.end());
+        CHECK(order == row_major);
+    }
+    CHECK(order_cells(13, Layout::RowMajor) == row_major);
+
+    // Tiles are stored one after another, the last ones cut short by the grid edge
+    std::vector<int> tiled = order_cells(5, Layout::Tiled, 2);
+    std::vector<int> first_tiles{0, 1, 5, 6, 2, 3};
+    CHECK(std::equal(first_tiles.begin(), first_tiles.end(), tiled.begin()));
+    CHECK(tiled.back() == 24);
+    std::vector<int> morton = order_cells(4, Layout::Morton);
+    std::vector<int> first_quads{0, 1, 4, 5, 2};
+    CHECK(std::equal(first_quads.begin(), first_quads.end(), morton.begin()));
+
+    std::vector<std::vector<int>> expected = run(Layout::RowMajor, 16, Layout::RowMajor);
+    CHECK(expected.back()[static_cast<int>(Status::Recovered)] > 100);
+    for (int tile : {1, 8, 16, 33}) {
+        CHECK(run(Layout::Tiled, tile, Layout::Tiled) == expected);
+    }
+    CHECK(run(Layout::Morton, 16, Layout::Morton) == expected);
+    CHECK(run(Layout::RowMajor, 16, Layout::Tiled) == expected);
+    CHECK(run(Layout::Morton, 8, Layout::RowMajor) == expected);
+    return 0;
+}
@@ -0,0 +1,90 @@
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "check.h"
+#include "disease.h"
+#include "memory.h"
+#include "model.h"
+#include "population.h"
+#include "record_policy.h"
+
+std::shared_ptr<Population> make_population(size_t memory_cap = 0) {
+    auto disease = std::make_shared<Disease>(0.6, 0.02, 4, 6, "flu");
+    return std::make_shared<Population>(60, 4, 5, 8, 2, disease, 3, "city", RandomMode::Sequential,
+                                        memory_cap);
+}
+
+// Whether building the model under the cap is refused
+bool refused(size_t memory_cap) {
+    try {
+        Model model(40, make_population(), "capped", RecordPolicy(), memory_cap);
+    } catch (const std::invalid_argument &) {
+        return true;
+    }
+    return false;
+}
+
+// Caps drop the neighbor table first, then frames, and refuse what cannot fit at all
+int main() {
+    // A population under a cap samples neighbors on the fly when the table does not fit
+    size_t cached = Population::estimate_memory(60, 4, true).total();
+    size_t sampled = Population::estimate_memory(60, 4, false).total();
+    CHECK(sampled < cached);
+    CHECK(make_population(cached)->get_neighbor_cache());
+    CHECK(!make_population(cached - 1)->get_neighbor_cache());
+    CHECK(make_population(sampled)->get_memory().total() <= sampled);
+    bool thrown = false;
+    try {
+        make_population(sampled - 1);
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    CHECK(thrown);
+
+    auto population = make_population();
+    RecordPolicy policy;
+    MemoryUsage full = Model::estimate_memory(40, *population, policy);
+    MemoryUsage no_frames = Model::estimate_memory(40, *population, RecordPolicy::stats_only());
+    CHECK(full.neighbors > 0 && no_frames.history < full.history);
+
+    // Room for everything changes nothing, and the run stays within the estimate
+    Model roomy(40, population, "roomy", policy, full.total());
+    roomy.set_verbose(false);
+    CHECK(population->get_neighbor_cache());
+    CHECK(roomy.get_policy().count_frames(40) == 41);
+    roomy.simulate(40);
+    CHECK(roomy.get_memory().total() <= full.total());
+    std::vector<std::vector<int>> expected = roomy.get_stats();
+
+    // A little less drops the neighbor table but keeps frames, and picks the same people
+    auto sampling = make_population();
+    Model without_table(40, sampling, "without table", policy, full.total() - full.neighbors);
+    without_table.set_verbose(false);
+    CHECK(!sampling->get_neighbor_cache());
+    CHECK(without_table.get_policy().count_frames(40) == 41);
+    without_table.simulate(40);
+    CHECK(without_table.get_stats() == expected);
+    CHECK(without_table.get_frames() == roomy.get_frames());
+
+    // Less again drops the frames too, stats are still recorded
+    auto lean = make_population();
+    size_t lean_cap = no_frames.total() - no_frames.neighbors;
+    Model stats_only(40, lean, "stats only", policy, lean_cap);
+    stats_only.set_verbose(false);
+    CHECK(stats_only.get_policy().count_frames(40) == 0);
+    stats_only.simulate(40);
+    CHECK(stats_only.get_frame_count() == 0);
+    CHECK(stats_only.get_stats() == expected);
+    CHECK(stats_only.get_memory().total() <= lean_cap);
+
+    // Below that nothing fits, and the population is left as it was
+    CHECK(refused(lean_cap - 1));
+    auto untouched = make_population();
+    try {
+        Model model(40, untouched, "refused", policy, lean_cap - 1);
+    } catch (const std::invalid_argument &) {
+    }
+    CHECK(untouched->get_neighbor_cache());
+    return 0;
+}
@@ -0,0 +1,68 @@
+#include <memory>
+#include <vector>
+
+#include "check.h"
+#include "disease.h"
+#include "metrics.h"
+#include "model.h"
+#include "person.h"
+#include "population.h"
+#include "record_policy.h"
+
+// Clusters of 8-connected carriers counted by flood fill over the whole grid
+int count_clusters(const Population &population) {
+    int size = population.get_size();
+    std::vector<int> grid(size * size, 0);
+    for (const Person *person : population.get_infectious_people()) {
+        grid[person->get_position().first * size + person->get_position().second] = 1;
+    }
+    int clusters = 0;
+    std::vector<int> stack;
+    for (int start = 0; start < size * size; ++start) {
+        if (grid[start] != 1) continue;
+        clusters += 1;
+        grid[start] = 2;
+        stack.push_back(start);
+        while (!stack.empty()) {
+            int cell = stack.back();
+            stack.pop_back();
+            for (int di = -1; di <= 1; ++di) {
+                for (int dj = -1; dj <= 1; ++dj) {
+                    int i = cell / size + di;
+                    int j = cell % size + dj;
+                    if (i < 0 || i >= size || j < 0 || j >= size || grid[i * size + j] != 1) {
+                        continue;
+                    }
+                    grid[i * size + j] = 2;
+                    stack.push_back(i * size + j);
+                }
+            }
+        }
+    }
+    return clusters;
+}
+
+int main() {
+    // Cases seeded after the model is built still anchor the front
+    auto disease = std::make_shared<Disease>(0.8, 0.0, 3, 4, "flu");
+    auto population = std::make_shared<Population>(40, 2, 4, 0, 0, disease, 3);
+    RecordPolicy policy = RecordPolicy::stats_only();
+    policy.set_metrics(true);
+    Model model(30, population, "metrics", policy);
+    model.set_verbose(false);
+    population->seed_incubations({820});
+
+    for (int day = 0; day < 30; ++day) {
+        model.simulate(1);
+        CHECK(model.get_metrics().back()[1] == count_clusters(*population));
+    }
+    std::vector<std::vector<double>> first = model.get_metrics();
+    CHECK(first.back()[0] > 0.0);
+
+    // A reset starts tracking afresh and repeats the run
+    model.reset(true);
+    population->seed_incubations({820});
+    model.simulate(30);
+    CHECK(model.get_metrics() == first);
+    return 0;
+}
@@ -0,0 +1,34 @@
+#include <memory>
+#include <vector>
+
+#include "check.h"
+#include "disease.h"
+#include "model.h"
+#include "population.h"
+#include "record_policy.h"
+
+// Explicit day lists record exactly those days, and an empty list records none
+int main() {
+    RecordPolicy none = RecordPolicy::on_days({});
+    for (int day = 0; day <= 30; ++day) CHECK(!none.records(day));
+    CHECK(none.count_frames(30) == 0);
+
+    RecordPolicy some = RecordPolicy::on_days({20, 0, 5, 5, 40});
+    CHECK(some.records(0) && some.records(5) && some.records(20));
+    CHECK(!some.records(1) && !some.records(40 - 1));
+    CHECK(some.count_frames(30) == 3);
+
+    RecordPolicy every = RecordPolicy::every(7);
+    CHECK(every.records(14) && !every.records(15));
+    CHECK(every.count_frames(30) == 5);
+
+    auto disease = std::make_shared<Disease>(0.6, 0.02, 4, 6, "flu");
+    auto population = std::make_shared<Population>(20, 1, 3, 2, 1, disease, 5);
+    Model model(30, population, "days", none);
+    model.set_verbose(false);
+    model.simulate(30);
+    CHECK(model.get_frame_count() == 0);
+    CHECK(model.get_frames().empty());
+    CHECK(model.get_stats().size() == 31);
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include <cstdint>
+#include <vector>
+
+#include "check.h"
+#include "renderer.h"
+
+// Color of output pixel (i, j) of the given frame
+Renderer::Color pixel(const std::vector<uint8_t> &out, int frame, int height, int width, int i,
+                      int j) {
+    const uint8_t *p = out.data() + 3 * ((static_cast<size_t>(frame) * height + i) * width + j);
+    return {p[0], p[1], p[2]};
+}
+
+// Scaled frames take the majority status of each block, ties going to the lower status
+int main() {
+    std::vector<Renderer::Color> palette = {{10, 0, 0}, {20, 0, 0}, {30, 0, 0}, {40, 0, 0}};
+    // clang-format off
+    std::vector<int> frame = {
+        0, 1, 2, 2, 3,
+        1, 1, 2, 0, 3,
+        3, 3, 0, 1, 9,
+        3, 0, 1, 0, 9,
+        2, 2, 9, 9, 9,
+    };
+    // clang-format on
+    Renderer renderer(palette, 2, 1);
+    CHECK(renderer.get_output_height(5) == 3 && renderer.get_output_width(5) == 3);
+
+    std::vector<uint8_t> out(3 * 3 * 3);
+    renderer.render(frame.data(), 1, 5, 5, out.data());
+    CHECK(pixel(out, 0, 3, 3, 0, 0) == palette[1]);  // Three 1s against one 0
+    CHECK(pixel(out, 0, 3, 3, 0, 1) == palette[2]);  // Two 2s against a 0
+    CHECK(pixel(out, 0, 3, 3, 0, 2) == palette[3]);  // Partial edge block of two 3s
+    CHECK(pixel(out, 0, 3, 3, 1, 0) == palette[3]);
+    CHECK(pixel(out, 0, 3, 3, 1, 1) == palette[0]);  // Tie of 0s and 1s goes to 0
+    CHECK(pixel(out, 0, 3, 3, 1, 2) == (Renderer::Color{0, 0, 0}));  // Only unknown statuses
+    CHECK(pixel(out, 0, 3, 3, 2, 0) == palette[2]);
+    CHECK(pixel(out, 0, 3, 3, 2, 1) == (Renderer::Color{0, 0, 0}));  // Unknowns do not vote
+
+    // Scale 1 maps every cell, unknown statuses turn black
+    Renderer exact(palette, 1, 1);
+    std::vector<uint8_t> full(5 * 5 * 3);
+    exact.render(frame.data(), 1, 5, 5, full.data());
+    CHECK(pixel(full, 0, 5, 5, 0, 4) == palette[3]);
+    CHECK(pixel(full, 0, 5, 5, 2, 4) == (Renderer::Color{0, 0, 0}));
+
+    // Byte frames, several frames and several threads give the same pixels
+    std::vector<uint8_t> bytes;
+    std::vector<int> frames;
+    for (int f = 0; f < 7; ++f) {
+        for (int value : frame) {
+            bytes.push_back(static_cast<uint8_t>((value + f) % 5));
+            frames.push_back((value + f) % 5);
+        }
+    }
+    std::vector<uint8_t> from_ints(7 * 3 * 3 * 3), from_bytes(7 * 3 * 3 * 3);
+    renderer.render(frames.data(), 7, 5, 5, from_ints.data());
+    Renderer(palette, 2, 3).render(bytes.data(), 7, 5, 5, from_bytes.data());
+    CHECK(from_ints == from_bytes);
+    CHECK(std::vector<uint8_t>(from_ints.begin(), from_ints.begin() + 27) == out);
+    CHECK(std::vector<uint8_t>(from_ints.begin() + 27, from_ints.begin() + 54) != out);
+    return 0;
+}
@@ -0,0 +1,56 @@
+#include <memory>
+#include <vector>
+
+#include "check.h"
+#include "disease.h"
+#include "model.h"
+#include "person.h"
+#include "population.h"
+#include "record_policy.h"
+#include "schedule.h"
+
+// Rerunning a scheduled model after reset must repeat the first run and leave shared inputs alone
+int main() {
+    auto disease = std::make_shared<Disease>(0.6, 0.02, 4, 6, "flu");
+    auto population = std::make_shared<Population>(100, 2, 5, 4, 1, disease, 11, "city",
+                                                   RandomMode::Keyed);
+    Model model(60, population, "city", RecordPolicy::stats_only());
+    model.set_verbose(false);
+
+    auto schedule = std::make_shared<Schedule>();
+    schedule->add_change(10, Parameter::Encounters, 2);
+    schedule->add_change(12, Parameter::TravelRadius, 1);
+    schedule->add_rule(Status::Infected, 20, Parameter::TransmissionRate, 0.3);
+    schedule->add_rule(Status::Infected, 20, Parameter::FatalityRate, 0.1);
+
+    model.simulate(60, schedule);
+    std::vector<std::vector<int>> first = model.get_stats();
+    CHECK(population->get_encounters() == 2);
+    CHECK(population->get_strain(0)->get_transmission_rate() == 0.3);
+    CHECK(disease->get_transmission_rate() == 0.6);
+    CHECK(disease->get_fatality_rate() == 0.02);
+
+    model.reset(true);
+    CHECK(population->get_encounters() == 5);
+    CHECK(population->get_travel_radius() == 2);
+    CHECK(population->get_strain(0)->get_transmission_rate() == 0.6);
+
+    model.simulate(60, schedule);
+    CHECK(model.get_stats() == first);
+
+    // One schedule shared by both arms of a paired run fires its rules in each of them
+    auto baseline_population = std::make_shared<Population>(100, 2, 5, 4, 1, disease, 11,
+                                                            "city", RandomMode::Keyed);
+    auto intervention_population = std::make_shared<Population>(100, 2, 5, 4, 1, disease, 11,
+                                                                "city", RandomMode::Keyed);
+    Model baseline(60, baseline_population, "baseline", RecordPolicy::stats_only());
+    Model intervention(60, intervention_population, "intervention", RecordPolicy::stats_only());
+    baseline.set_verbose(false);
+    intervention.set_verbose(false);
+    simulate_paired(baseline, intervention, 60, schedule, schedule);
+    CHECK(baseline_population->get_strain(0)->get_transmission_rate() == 0.3);
+    CHECK(intervention_population->get_strain(0)->get_transmission_rate() == 0.3);
+    CHECK(baseline.get_stats() == first);
+    CHECK(intervention.get_stats() == first);
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "check.h"
+#include "disease.h"
+#include "person.h"
+#include "population.h"
+
+// Carriers who recover and are reinfected by another strain on the same day must stay listed once
+void check_reinfection(bool batched) {
+    auto disease = std::make_shared<Disease>(0.9, 0.0, 2, 2, "first");
+    Population population(60, 2, 6, 20, 10, disease, 7, "strains", RandomMode::Keyed);
+    population.add_strain(std::make_shared<Disease>(0.9, 0.0, 2, 2, "second"), 0.0);
+    population.seed_incubations({30, 1830, 3570}, 1);
+    population.set_batched(batched);
+
+    for (int day = 0; day < 120; ++day) {
+        population.update();
+        const std::vector<Person *> &infectious = population.get_infectious_people();
+        std::set<const Person *> unique(infectious.begin(), infectious.end());
+        CHECK(unique.size() == infectious.size());
+
+        const std::vector<int> &count = population.get_status_count();
+        int carriers = count[static_cast<int>(Status::Incubated)] +
+                       count[static_cast<int>(Status::Infected)];
+        CHECK(static_cast<int>(infectious.size()) == carriers);
+    }
+}
+
+// Infections beyond the first per person, checking per-strain carriers against the status counts
+int count_reinfections(double cross_immunity) {
+    auto disease = std::make_shared<Disease>(0.8, 0.0, 2, 3, "first");
+    Population population(50, 2, 6, 10, 5, disease, 5);
+    population.add_strain(std::make_shared<Disease>(0.8, 0.0, 2, 3, "second"), cross_immunity);
+    population.seed_incubations({1275, 80, 2420}, 1);
+
+    for (int day = 0; day < 80; ++day) {
+        population.update();
+        const std::vector<int> &strains = population.get_strain_counts();
+        const std::vector<int> &count = population.get_status_count();
+        CHECK(strains[0] + strains[3] == count[static_cast<int>(Status::Incubated)]);
+        CHECK(strains[1] + strains[4] == count[static_cast<int>(Status::Infected)]);
+    }
+    const std::vector<int> &strains = population.get_strain_counts();
+    CHECK(strains[2] > 10 && strains[5] > 3);
+    int infected = 50 * 50 - population.get_status_count()[static_cast<int>(Status::Susceptible)];
+    return strains[2] + strains[5] - infected;
+}
+
+// A strain that cannot transmit stays with the people it was seeded in
+void check_contained_strain() {
+    auto disease = std::make_shared<Disease>(0.8, 0.0, 2, 3, "first");
+    Population population(40, 2, 6, 10, 5, disease, 9);
+    population.add_strain(std::make_shared<Disease>(0.0, 0.0, 2, 3, "inert"), 0.0);
+    int seeded = population.seed_incubations({0, 820, 1599}, 1);
+    CHECK(seeded > 0);
+    for (int day = 0; day < 60; ++day) population.update();
+    CHECK(population.get_strain_counts()[5] == seeded);
+    CHECK(population.get_strain_counts()[2] > 100);
+}
+
+int main() {
+    check_reinfection(false);
+    check_reinfection(true);
+
+    // Full cross-immunity lets nobody catch a second strain, none lets recovered people catch it
+    CHECK(count_reinfections(1.0) == 0);
+    CHECK(count_reinfections(0.0) > 0);
+    check_contained_strain();
+    return 0;
+}
@@ -0,0 +1,64 @@
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "check.h"
+#include "disease.h"
+#include "layout.h"
+#include "population.h"
+#include "topology.h"
+
+// Per-day status counts of the population over 40 days
+std::vector<std::vector<int>> run(Population &population) {
+    std::vector<std::vector<int>> counts{population.get_status_count()};
+    for (int day = 0; day < 40; ++day) {
+        population.update();
+        counts.push_back(population.get_status_count());
+    }
+    return counts;
+}
+
+// Populations sharing one topology behave like standalone ones and never change it for each other
+int main() {
+    auto disease = std::make_shared<Disease>(0.6, 0.02, 4, 6, "flu");
+    Population standalone(50, 3, 5, 8, 2, disease, 4);
+    std::vector<std::vector<int>> expected = run(standalone);
+
+    // Two populations on one topology, updated at the same time on two threads
+    auto topology = std::make_shared<const Topology>(50, 3);
+    Population first(topology, 5, 8, 2, disease, 4);
+    Population second(topology, 5, 8, 2, disease, 4);
+    std::vector<std::vector<int>> first_counts, second_counts;
+    std::thread worker([&] { first_counts = run(first); });
+    second_counts = run(second);
+    worker.join();
+    CHECK(first_counts == expected);
+    CHECK(second_counts == expected);
+
+    // Changing one population gives it its own copy, the other keeps the shared topology
+    std::vector<int> zones(50 * 50, 0);
+    for (int cell = 0; cell < 25 * 50; ++cell) zones[cell] = 1;
+    first.set_zones(zones);
+    CHECK(first.get_topology() != topology);
+    CHECK(first.get_zone_count() == 2);
+    CHECK(second.get_topology() == topology);
+    CHECK(topology->get_zone_count() == 0);
+
+    // Copies keep the neighbor table while it is still valid and rebuild it otherwise
+    auto zoned = topology->with_zones(zones);
+    CHECK(zoned->get_neighbors(0) == topology->get_neighbors(0));
+    CHECK(first.get_topology()->get_neighbors(0) == topology->get_neighbors(0));
+    auto wider = topology->with_travel_radius(4);
+    CHECK(wider->get_neighbors(0) != topology->get_neighbors(0));
+    CHECK(wider->get_neighbor_count(0) > topology->get_neighbor_count(0));
+    auto tiled = topology->with_layout(Layout::Tiled, 8);
+    CHECK(tiled->get_layout() == Layout::Tiled && topology->get_layout() == Layout::RowMajor);
+    auto sampled = topology->with_neighbor_cache(false);
+    CHECK(!sampled->get_neighbor_cache() && topology->get_neighbor_cache());
+    CHECK(sampled->get_memory().neighbors == 0);
+
+    // A population on a sampled-neighbor topology still picks the same people
+    Population sampling(sampled, 5, 8, 2, disease, 4);
+    CHECK(run(sampling) == expected);
+    return 0;
+}
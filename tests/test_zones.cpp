@@ -0,0 +1,37 @@
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "check.h"
+#include "disease.h"
+#include "model.h"
+#include "population.h"
+#include "record_policy.h"
+
+// Zone stats rows keep the width the model started with until the model is reset
+int main() {
+    auto disease = std::make_shared<Disease>(0.6, 0.02, 4, 6, "flu");
+    auto population = std::make_shared<Population>(20, 1, 3, 2, 1, disease, 5);
+    population->set_zones(std::vector<int>(400, 0));
+    Model model(10, population, "zones", RecordPolicy::stats_only());
+    model.set_verbose(false);
+    model.simulate(3);
+
+    std::vector<int> zones(400);
+    for (int cell = 0; cell < 400; ++cell) zones[cell] = cell % 4;
+    population->set_zones(zones);
+    bool threw = false;
+    try {
+        model.simulate(3);
+    } catch (const std::runtime_error &) {
+        threw = true;
+    }
+    CHECK(threw);
+    CHECK(model.get_current_day() == 4);
+    for (const auto &row : model.get_zone_stats()) CHECK(row.size() == 5);
+
+    model.reset();
+    model.simulate(3);
+    for (const auto &row : model.get_zone_stats()) CHECK(row.size() == 20);
+    return 0;
+}